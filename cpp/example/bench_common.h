@@ -0,0 +1,113 @@
+#ifndef DLT645_EXAMPLE_BENCH_COMMON_H
+#define DLT645_EXAMPLE_BENCH_COMMON_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <boost/asio.hpp>
+#include "dlt645/service/server_service.h"
+#include "dlt645/transport/client/client_api.h"
+#include "dlt645/transport/io_context_pool.h"
+
+// 基准测试和测试程序共用的辅助：本机端口分配、表计地址、读取结果统计、本机TCP服务端和客户端
+
+namespace dlt645 {
+    namespace bench {
+
+        // 各程序监听的本机端口，集中分配，多个程序可以同时运行
+        namespace port {
+            constexpr uint16_t TCP_SERVER = 10621;
+            constexpr uint16_t RECONNECT_STORM = 10622;
+            constexpr uint16_t CLIENT_RUNTIME = 10623;
+            constexpr uint16_t TCP_PIPELINE = 10624;
+            constexpr uint16_t COROUTINE_READS = 10625;
+            constexpr uint16_t POLL_SCHEDULER = 10626;
+            constexpr uint16_t ADAPTIVE_TIMEOUT = 10627;
+            constexpr uint16_t TCP_CLIENT_POOL = 10628;
+            constexpr uint16_t DEVICE_HEALTH = 10629;
+        } // namespace port
+
+        // 第i个表计的地址：12位十进制表号的BCD码（低字节在前），0号为服务端自身地址
+        inline std::array<uint8_t, 6> meterAddress(size_t i)
+        {
+            std::array<uint8_t, 6> address {};
+            for (auto& b : address) {
+                b = static_cast<uint8_t>((i % 10) | (i / 10 % 10) << 4);
+                i /= 100;
+            }
+            return address;
+        }
+
+        // 一组读取的结果
+        struct ReadResult {
+            size_t ok = 0;
+            size_t failed = 0;
+            double seconds = 0;
+
+            // 每秒成功读取次数
+            double rate() const { return seconds > 0 ? static_cast<double>(ok) / seconds : 0; }
+        };
+
+        // 在当前线程上运行spawn(io, result)启动的读取协程，直到全部结束，记录耗时
+        template <typename Spawn>
+        ReadResult runCoroutines(Spawn&& spawn)
+        {
+            ReadResult result;
+            boost::asio::io_context io(1);
+            auto start = std::chrono::steady_clock::now();
+            spawn(io, result);
+            io.run();
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return result;
+        }
+
+        // 创建本机TCP服务端（已init，未start）：服务端地址为0号表计，可登记maxMeters个虚拟表计（为0时不启用），不限制连接数
+        inline std::shared_ptr<service::ServerService> makeTcpServer(uint16_t port, size_t maxMeters = 0)
+        {
+            auto tcpServer = std::make_shared<transport::server::TcpServer>();
+            transport::server::TcpServerConfig config;
+            config.ip = "127.0.0.1";
+            config.port = port;
+            config.maxConnections = 0;
+            tcpServer->configure(config);
+            auto server = std::make_shared<service::ServerService>(tcpServer, meterAddress(0));
+            server->init();
+            if (maxMeters > 0) {
+                server->enableVirtualMeters(maxMeters);
+            }
+            return server;
+        }
+
+        // 登记1~meters号表计并启动服务端，失败时打印错误
+        inline bool startTcpServer(service::ServerService& server, size_t meters = 0)
+        {
+            for (size_t i = 1; i <= meters; ++i) {
+                server.addMeter(meterAddress(i));
+            }
+            if (!server.start()) {
+                std::fprintf(stderr, "failed to start server\n");
+                return false;
+            }
+            return true;
+        }
+
+        // 连接本机端口的TCP客户端（未连接），pool为空时使用独占的IO线程
+        inline std::shared_ptr<transport::client::TcpClient> makeTcpClient(uint16_t port,
+                                                                           size_t maxInFlight = 1,
+                                                                           std::shared_ptr<transport::IoContextPool> pool = nullptr)
+        {
+            auto client = std::make_shared<transport::client::TcpClient>(std::move(pool));
+            transport::client::TcpClientConfig config;
+            config.ip = "127.0.0.1";
+            config.port = port;
+            config.maxInFlight = maxInFlight;
+            client->configure(config);
+            return client;
+        }
+
+    } // namespace bench
+} // namespace dlt645
+
+#endif // DLT645_EXAMPLE_BENCH_COMMON_H
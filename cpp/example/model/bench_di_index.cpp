@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "dlt645/model/data_item.h"
+#include "dlt645/model/di_index.h"
+
+// DI索引查找延迟基准测试：原std::unordered_map<uint32_t, DataItem>对比扁平DiIndex
+// 用法: bench_di_index [查找次数]
+
+namespace {
+
+    using namespace dlt645::model;
+
+    // 生成与电能/需量类似的DI：DI3=00H/01H，DI2为类别，DI1为费率，DI0为结算日（00H..0CH）
+    std::vector<uint32_t> makeDis()
+    {
+        std::vector<uint32_t> dis;
+        for (uint32_t di3 = 0x00; di3 <= 0x01; ++di3) {
+            for (uint32_t di2 = 0x00; di2 <= 0x0A; ++di2) {
+                for (uint32_t di1 = 0x00; di1 <= 0x3F; ++di1) {
+                    for (uint32_t di0 = 0x00; di0 <= 0x0C; ++di0) {
+                        dis.push_back(di3 << 24 | di2 << 16 | di1 << 8 | di0);
+                    }
+                }
+            }
+        }
+        return dis;
+    }
+
+    template <typename Fn>
+    double measure(Fn&& fn, const std::vector<uint32_t>& keys)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t key : keys) {
+            fn(key);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(keys.size());
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t lookups = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+
+    std::vector<uint32_t> dis = makeDis();
+
+    // 原结构：DI到完整DataItem的哈希表
+    std::unordered_map<uint32_t, DataItem> map;
+    std::vector<std::pair<uint32_t, uint32_t>> entries;
+    for (uint32_t i = 0; i < dis.size(); ++i) {
+        map.emplace(dis[i], DataItem(dis[i], "(当前)组合有功总电能", DataFormat::XXXXXX_XX, 0.0f, "kWh"));
+        entries.emplace_back(dis[i], i);
+    }
+    DiIndex index(entries);
+
+    // 随机命中与随机未命中的查找序列
+    std::mt19937 rng(645);
+    std::uniform_int_distribution<size_t> pick(0, dis.size() - 1);
+    std::vector<uint32_t> hits(lookups);
+    std::vector<uint32_t> misses(lookups);
+    for (size_t i = 0; i < lookups; ++i) {
+        hits[i] = dis[pick(rng)];
+        misses[i] = dis[pick(rng)] | 0x000000F0;
+    }
+
+    // 结果汇总到sink中，防止编译器优化掉调用
+    volatile uint32_t sink = 0;
+
+    std::printf("entries=%zu, lookups=%zu\n", dis.size(), lookups);
+    std::printf("%-16s %12s %12s\n", "index", "hit ns/op", "miss ns/op");
+
+    double hitNs = measure(
+        [&](uint32_t di) {
+            auto it = map.find(di);
+            sink = sink + (it != map.end() ? static_cast<uint32_t>(it->second.dataFormat) : 0);
+        },
+        hits);
+    double missNs = measure([&](uint32_t di) { sink = sink + static_cast<uint32_t>(map.count(di)); }, misses);
+    std::printf("%-16s %12.2f %12.2f\n", "unordered_map", hitNs, missNs);
+
+    hitNs = measure([&](uint32_t di) { sink = sink + index.find(di); }, hits);
+    missNs = measure([&](uint32_t di) { sink = sink + index.find(di); }, misses);
+    std::printf("%-16s %12.2f %12.2f\n", "DiIndex", hitNs, missNs);
+
+    // 结算日范围查询：原结构需逐个DI0查找，DiIndex为一段连续数组
+    std::vector<uint32_t> prefixes(lookups / 16 + 1);
+    for (auto& prefix : prefixes) {
+        prefix = dis[pick(rng)];
+    }
+    double mapRangeNs = measure(
+        [&](uint32_t di) {
+            for (uint32_t di0 = 0; di0 <= 0xFF; ++di0) {
+                sink = sink + static_cast<uint32_t>(map.count((di & 0xFFFFFF00) | di0));
+            }
+        },
+        prefixes);
+    double indexRangeNs = measure(
+        [&](uint32_t di) {
+            for (uint32_t slot : index.settlementDays(di).slots) {
+                sink = sink + slot;
+            }
+        },
+        prefixes);
+    std::printf("%-16s %12.2f ns/op (unordered_map) %12.2f ns/op (DiIndex)\n", "settlement days", mapRangeNs,
+                indexRangeNs);
+
+    return 0;
+}
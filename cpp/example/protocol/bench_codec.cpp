@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "dlt645/protocol/codec.h"
+
+// 数据域±33H转换与校验和内核的微基准测试
+// 计时前先把每个内核与标量实现逐字节对比（长度0~300、输入输出各种对齐偏移及原地转换），不一致时返回1
+// 用法: bench_codec [数据域长度] [迭代次数]
+
+namespace {
+
+    using namespace dlt645::protocol;
+
+    // 原实现：先逐字节转换，再单独求校验和
+    uint8_t legacyEncode(const uint8_t* in, uint8_t* out, size_t n)
+    {
+        std::transform(in, in + n, out, [](uint8_t b) { return static_cast<uint8_t>(b + 0x33); });
+        uint8_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += out[i];
+        }
+        return sum;
+    }
+
+    uint8_t legacyDecode(const uint8_t* in, uint8_t* out, size_t n)
+    {
+        uint8_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += in[i];
+        }
+        std::transform(in, in + n, out, [](uint8_t b) { return static_cast<uint8_t>(b - 0x33); });
+        return sum;
+    }
+
+    constexpr size_t VERIFY_MAX_LEN = 300;
+    constexpr size_t VERIFY_ALIGNMENTS = 32; // 覆盖AVX2的32字节对齐内的所有偏移
+    constexpr uint8_t CANARY = 0xA5;         // 输出区域之外的字节不应被改写
+
+    // 以标量实现为基准对比一个内核的输出缓冲区和返回值，返回是否一致
+    bool verify(const codec::Kernel& kernel)
+    {
+        const codec::Kernel& scalar = codec::scalarKernel();
+        std::mt19937 rng(33);
+        std::vector<uint8_t> source(VERIFY_MAX_LEN + VERIFY_ALIGNMENTS);
+        std::ranges::generate(source, [&rng] { return static_cast<uint8_t>(rng()); });
+
+        std::vector<uint8_t> expected(VERIFY_MAX_LEN);
+        std::vector<uint8_t> actual(VERIFY_MAX_LEN + 2 * VERIFY_ALIGNMENTS);
+        auto report = [&kernel](const char* op, size_t len, size_t inOffset, size_t outOffset) {
+            std::printf("%-10s %s mismatch: len=%zu in+%zu out+%zu\n", kernel.name, op, len, inOffset, outOffset);
+            return false;
+        };
+
+        for (size_t len = 0; len <= VERIFY_MAX_LEN; ++len) {
+            for (size_t inOffset = 0; inOffset < VERIFY_ALIGNMENTS; ++inOffset) {
+                const uint8_t* in = source.data() + inOffset;
+                if (kernel.sum(in, len) != scalar.sum(in, len)) {
+                    return report("sum", len, inOffset, 0);
+                }
+
+                for (size_t outOffset = 0; outOffset < VERIFY_ALIGNMENTS; ++outOffset) {
+                    for (bool isEncode : { true, false }) {
+                        auto fn = isEncode ? kernel.encode : kernel.decode;
+                        auto reference = isEncode ? scalar.encode : scalar.decode;
+                        uint8_t expectSum = reference(in, expected.data(), len);
+
+                        std::ranges::fill(actual, CANARY);
+                        uint8_t* out = actual.data() + outOffset;
+                        uint8_t sum = fn(in, out, len);
+                        bool untouched = std::all_of(actual.begin(), actual.begin() + outOffset, [](uint8_t b) { return b == CANARY; })
+                                         && std::all_of(out + len, actual.data() + actual.size(), [](uint8_t b) { return b == CANARY; });
+                        if (sum != expectSum || !std::equal(out, out + len, expected.data()) || !untouched) {
+                            return report(isEncode ? "encode" : "decode", len, inOffset, outOffset);
+                        }
+                    }
+                }
+
+                // 原地转换（out与in指向同一缓冲区）
+                for (bool isEncode : { true, false }) {
+                    auto fn = isEncode ? kernel.encode : kernel.decode;
+                    auto reference = isEncode ? scalar.encode : scalar.decode;
+                    uint8_t expectSum = reference(in, expected.data(), len);
+
+                    std::copy(in, in + len, actual.data() + inOffset);
+                    uint8_t* inout = actual.data() + inOffset;
+                    if (fn(inout, inout, len) != expectSum || !std::equal(inout, inout + len, expected.data())) {
+                        return report(isEncode ? "in-place encode" : "in-place decode", len, inOffset, inOffset);
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename Fn>
+    double measure(Fn&& fn, size_t iterations)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            fn();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t len = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    size_t iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 5000000;
+
+    std::vector<uint8_t> in(len);
+    std::vector<uint8_t> out(len);
+    std::mt19937 rng(645);
+    std::ranges::generate(in, [&rng] { return static_cast<uint8_t>(rng()); });
+
+    // 结果汇总到sink中，防止编译器优化掉调用
+    volatile uint8_t sink = 0;
+
+    uint8_t expectEncode = legacyEncode(in.data(), out.data(), len);
+    uint8_t expectDecode = legacyDecode(in.data(), out.data(), len);
+
+    std::printf("payload=%zu bytes, iterations=%zu, active kernel=%s\n", len, iterations, codec::kernelName());
+    std::printf("%-10s %14s %14s %14s\n", "kernel", "encode ns/op", "decode ns/op", "sum ns/op");
+
+    double encodeNs = measure([&] { sink = sink + legacyEncode(in.data(), out.data(), len); }, iterations);
+    double decodeNs = measure([&] { sink = sink + legacyDecode(in.data(), out.data(), len); }, iterations);
+    std::printf("%-10s %14.2f %14.2f %14s\n", "legacy", encodeNs, decodeNs, "-");
+
+    std::array<const codec::Kernel*, 8> kernels = { nullptr };
+    size_t count = codec::availableKernels(kernels);
+    for (size_t k = 0; k < count; ++k) {
+        const codec::Kernel& kernel = *kernels[k];
+        if (kernel.encode(in.data(), out.data(), len) != expectEncode
+            || kernel.decode(in.data(), out.data(), len) != expectDecode) {
+            std::printf("%-10s checksum mismatch\n", kernel.name);
+            return 1;
+        }
+        if (!verify(kernel)) {
+            return 1;
+        }
+
+        encodeNs = measure([&] { sink = sink + kernel.encode(in.data(), out.data(), len); }, iterations);
+        decodeNs = measure([&] { sink = sink + kernel.decode(in.data(), out.data(), len); }, iterations);
+        double sumNs = measure([&] { sink = sink + kernel.sum(in.data(), len); }, iterations);
+        std::printf("%-10s %14.2f %14.2f %14.2f\n", kernel.name, encodeNs, decodeNs, sumNs);
+    }
+
+    return 0;
+}
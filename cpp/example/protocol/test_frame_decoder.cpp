@@ -0,0 +1,119 @@
+#include <array>
+#include <cstdio>
+#include <span>
+#include <vector>
+#include "dlt645/protocol/protocol.h"
+
+// 流式帧解码器测试：垃圾字节后的重同步、跨分片的帧、一个分片中的多个帧、校验和错误
+// 全部通过时返回0
+
+namespace {
+
+    using dlt645::protocol::Frame;
+    using dlt645::protocol::FrameDecoder;
+    using dlt645::protocol::FrameView;
+
+    constexpr std::array<uint8_t, 6> ADDRESS = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+
+    int failures = 0;
+
+    void check(bool ok, const char* name)
+    {
+        std::printf("%-32s %s\n", name, ok ? "通过" : "失败");
+        if (!ok) {
+            ++failures;
+        }
+    }
+
+    // 输入一段字节，返回解出的各帧（不含前导字节）
+    std::vector<std::vector<uint8_t>> feed(FrameDecoder& decoder, std::span<const uint8_t> bytes)
+    {
+        std::vector<std::vector<uint8_t>> frames;
+        decoder.feed(bytes, [&frames](const FrameView& frame) { frames.emplace_back(frame.raw().begin(), frame.raw().end()); });
+        return frames;
+    }
+
+    // 去掉前导FEH后的帧字节
+    std::vector<uint8_t> body(const std::vector<uint8_t>& frame)
+    {
+        auto start = frame.begin();
+        while (start != frame.end() && *start == 0xFE) {
+            ++start;
+        }
+        return { start, frame.end() };
+    }
+
+    std::vector<uint8_t> concat(std::initializer_list<std::vector<uint8_t>> parts)
+    {
+        std::vector<uint8_t> result;
+        for (const auto& part : parts) {
+            result.insert(result.end(), part.begin(), part.end());
+        }
+        return result;
+    }
+
+} // namespace
+
+int main()
+{
+    // 读数据请求、带4字节数据的应答、无数据域的读地址请求
+    const auto request = Frame::buildFrame(ADDRESS, 0x11, { 0x00, 0x00, 0x01, 0x00 });
+    const auto response = Frame::buildFrame(ADDRESS, 0x91, { 0x00, 0x00, 0x01, 0x00, 0x56, 0x34, 0x12, 0x00 });
+    const auto readAddress = Frame::buildFrame(ADDRESS, 0x13, {});
+
+    // 重同步：无效字节及一个假帧头（68H后跟地址，第二个68H位置不符）之后是真正的帧，
+    // 假帧头吞掉的字节里包含真正帧的68H，需要回放已缓存的字节
+    {
+        FrameDecoder decoder;
+        auto stream = concat({ { 0x12, 0x34, 0x68, 0x00 }, request });
+        auto frames = feed(decoder, stream);
+        check(frames.size() == 1 && frames[0] == body(request), "重同步：垃圾字节后解出帧");
+        check(decoder.discardedBytes() > 0, "重同步：统计丢弃的字节");
+        check(decoder.idle(), "重同步：解出后回到帧间");
+    }
+
+    // 跨分片：在每个位置切开，前一段不解出帧，后一段解出完整的帧
+    {
+        bool ok = true;
+        for (size_t split = 1; split < response.size(); ++split) {
+            FrameDecoder decoder;
+            std::span<const uint8_t> bytes(response);
+            auto first = feed(decoder, bytes.first(split));
+            auto second = feed(decoder, bytes.subspan(split));
+            ok = ok && first.empty() && second.size() == 1 && second[0] == body(response) && decoder.idle();
+        }
+        check(ok, "跨分片：任意切分位置");
+
+        // 逐字节输入
+        FrameDecoder decoder;
+        size_t count = 0;
+        for (uint8_t b : response) {
+            count += feed(decoder, std::span<const uint8_t>(&b, 1)).size();
+        }
+        check(count == 1, "跨分片：逐字节输入");
+    }
+
+    // 一个分片中的多个帧按顺序解出
+    {
+        FrameDecoder decoder;
+        auto stream = concat({ request, response, readAddress });
+        auto frames = feed(decoder, stream);
+        check(frames.size() == 3 && frames[0] == body(request) && frames[1] == body(response) && frames[2] == body(readAddress),
+              "多帧：一个分片中的三个帧");
+    }
+
+    // 校验和错误：该帧被丢弃，紧随其后的帧仍能解出
+    {
+        FrameDecoder decoder;
+        auto corrupted = response;
+        corrupted[corrupted.size() - 2] ^= 0x01;
+        auto stream = concat({ corrupted, request });
+        auto frames = feed(decoder, stream);
+        check(frames.size() == 1 && frames[0] == body(request), "校验失败：丢弃错误帧");
+        check(decoder.discardedBytes() >= body(corrupted).size(), "校验失败：统计丢弃的字节");
+        check(!FrameView::parse(corrupted).has_value(), "校验失败：FrameView同样拒绝");
+    }
+
+    std::printf("%s\n", failures == 0 ? "全部通过" : "存在失败的用例");
+    return failures == 0 ? 0 : 1;
+}
@@ -53,7 +53,7 @@ int main()
         if (energyData) {
             std::cout << "Energy data: " << std::endl;
             std::cout << "  Name: " << energyData->name << std::endl;
-            std::cout << "  Format: " << energyData->dataFormat << std::endl;
+            std::cout << "  Format: " << model::toString(energyData->dataFormat) << std::endl;
             std::cout << "  Unit: " << energyData->unit << std::endl;
             if (std::holds_alternative<float>(energyData->value)) {
                 std::cout << "  Value: " << std::get<float>(energyData->value) << std::endl;
@@ -68,7 +68,7 @@ int main()
         if (demandData) {
             std::cout << "Demand data: " << std::endl;
             std::cout << "  Name: " << demandData->name << std::endl;
-            std::cout << "  Format: " << demandData->dataFormat << std::endl;
+            std::cout << "  Format: " << model::toString(demandData->dataFormat) << std::endl;
             std::cout << "  Unit: " << demandData->unit << std::endl;
             // 判断是否为需量
             if (std::holds_alternative<model::Demand>(demandData->value)) {
@@ -86,7 +86,7 @@ int main()
         if (variableData) {
             std::cout << "Variable data: " << std::endl;
             std::cout << "  Name: " << variableData->name << std::endl;
-            std::cout << "  Format: " << variableData->dataFormat << std::endl;
+            std::cout << "  Format: " << model::toString(variableData->dataFormat) << std::endl;
             std::cout << "  Unit: " << variableData->unit << std::endl;
             if (std::holds_alternative<float>(variableData->value)) {
                 std::cout << "  Value: " << std::get<float>(variableData->value) << std::endl;
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <boost/asio.hpp>
+#include <spdlog/spdlog.h>
+#include "dlt645/service/client_service.h"
+#include "dlt645/service/server_service.h"
+#include "dlt645/transport/io_context_pool.h"
+#include "../bench_common.h"
+
+// 自适应超时与熔断基准测试：一条链路（窗口为1，等同于一条RS-485总线）上轮流读取多个表计，
+// 其中部分表计地址没有在服务端登记（模拟掉线表计，永远不应答）
+//   fixed     固定应答超时、不熔断，每轮都要为掉线表计等满超时
+//   adaptive  按往返时延自适应超时，掉线表计连续失败后熔断，直接失败不占用链路
+// 用法: bench_adaptive_timeout [表计数] [掉线表计数] [固定超时ms] [运行秒数]
+
+namespace {
+
+    using namespace dlt645;
+    using bench::meterAddress;
+
+    // 按顺序轮流读取各表计，直到运行时间用完
+    boost::asio::awaitable<void> readRounds(const std::vector<std::shared_ptr<service::ClientService>>& clients,
+                                            std::chrono::steady_clock::time_point deadline,
+                                            bench::ReadResult& result)
+    {
+        while (std::chrono::steady_clock::now() < deadline) {
+            for (const auto& client : clients) {
+                auto item = co_await client->asyncReadDataItem(0x00000000);
+                ++(item ? result.ok : result.failed);
+            }
+        }
+    }
+
+    bench::ReadResult run(const std::vector<std::shared_ptr<service::ClientService>>& clients, long seconds)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+        return bench::runCoroutines([&](boost::asio::io_context& io, bench::ReadResult& result) {
+            boost::asio::co_spawn(io, readRounds(clients, deadline, result), boost::asio::detached);
+        });
+    }
+
+    const char* stateName(service::CircuitState state)
+    {
+        switch (state) {
+        case service::CircuitState::Closed:
+            return "closed";
+        case service::CircuitState::Open:
+            return "open";
+        case service::CircuitState::HalfOpen:
+            return "half-open";
+        }
+        return "?";
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t meterCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10;
+    size_t deadCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2;
+    long timeoutMs = argc > 3 ? std::strtol(argv[3], nullptr, 10) : 500;
+    long seconds = argc > 4 ? std::strtol(argv[4], nullptr, 10) : 5;
+    deadCount = std::min(deadCount, meterCount);
+
+    spdlog::set_level(spdlog::level::off);
+    DIManager::preInit();
+
+    auto server = bench::makeTcpServer(bench::port::ADAPTIVE_TIMEOUT, meterCount);
+    server->set00(0x00000000, 1234.56f);
+    // 前meterCount - deadCount个表计在线，其余地址不登记
+    if (!bench::startTcpServer(*server, meterCount - deadCount)) {
+        return 1;
+    }
+
+    auto pool = std::make_shared<transport::IoContextPool>(1);
+    pool->run();
+    auto connection = bench::makeTcpClient(bench::port::ADAPTIVE_TIMEOUT, 1, pool);
+    if (!connection->connect(std::chrono::milliseconds(timeoutMs))) {
+        std::fprintf(stderr, "failed to connect\n");
+        return 1;
+    }
+
+    std::printf("meters=%zu dead=%zu timeout=%ldms seconds=%ld\n", meterCount, deadCount, timeoutMs, seconds);
+
+    auto makeClients = [&](const service::DeviceHealthConfig& health) {
+        std::vector<std::shared_ptr<service::ClientService>> clients;
+        for (size_t i = 1; i <= meterCount; ++i) {
+            clients.push_back(std::make_shared<service::ClientService>(connection));
+            clients.back()->setAddress(meterAddress(i));
+            clients.back()->setHealthConfig(health);
+        }
+        return clients;
+    };
+
+    // 固定超时：超时上下限相同，熔断阈值取最大值
+    service::DeviceHealthConfig fixedConfig;
+    fixedConfig.initialTimeout = std::chrono::milliseconds(timeoutMs);
+    fixedConfig.minTimeout = fixedConfig.initialTimeout;
+    fixedConfig.maxTimeout = fixedConfig.initialTimeout;
+    fixedConfig.failureThreshold = UINT32_MAX;
+    // ClientService析构时会断开连接，两组客户端都保留到测试结束
+    auto fixedClients = makeClients(fixedConfig);
+    auto fixed = run(fixedClients, seconds);
+    std::printf("%-10s ok=%zu failed=%zu %.1f ok reads/s\n", "fixed", fixed.ok, fixed.failed, fixed.rate());
+
+    service::DeviceHealthConfig adaptiveConfig;
+    adaptiveConfig.maxTimeout = std::chrono::milliseconds(timeoutMs);
+    adaptiveConfig.initialTimeout = std::min(adaptiveConfig.initialTimeout, adaptiveConfig.maxTimeout);
+    auto clients = makeClients(adaptiveConfig);
+    auto adaptive = run(clients, seconds);
+    std::printf("%-10s ok=%zu failed=%zu %.1f ok reads/s\n", "adaptive", adaptive.ok, adaptive.failed, adaptive.rate());
+
+    // 一个在线表计和一个掉线表计的健康状态
+    for (size_t i : { size_t(0), meterCount - 1 }) {
+        auto stats = clients[i]->health();
+        std::printf("meter %zu: state=%s srtt=%lldus timeout=%lldms ok=%llu failed=%llu rejected=%llu\n",
+                    i + 1,
+                    stateName(stats.state),
+                    static_cast<long long>(stats.srtt.count()),
+                    static_cast<long long>(stats.timeout.count()),
+                    static_cast<unsigned long long>(stats.successes),
+                    static_cast<unsigned long long>(stats.failures),
+                    static_cast<unsigned long long>(stats.rejected));
+    }
+
+    connection->disconnect();
+    pool->stop();
+    server->stop();
+    return adaptive.ok > fixed.ok ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/asio.hpp>
+#include "dlt645/common/log.h"
+#include "dlt645/service/client_service.h"
+#include "dlt645/service/server_service.h"
+#include "dlt645/transport/io_context_pool.h"
+#include "../bench_common.h"
+
+// 协程读取基准测试：一个线程上的协程并发读取大量表计
+// 每个客户端连接开启流水线窗口，连接上同时运行多个读取协程；所有协程由同一个io_context线程驱动，等待响应时不阻塞线程
+// 用法: bench_coroutine_reads [连接数] [每连接协程数] [每协程读取次数]
+
+namespace {
+
+    using namespace dlt645;
+
+    // 当前进程的线程数
+    int threadCount()
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.rfind("Threads:", 0) == 0) {
+                return std::atoi(line.c_str() + 8);
+            }
+        }
+        return -1;
+    }
+
+    boost::asio::awaitable<void> readLoop(std::shared_ptr<service::ClientService> client,
+                                          size_t reads,
+                                          std::atomic<size_t>& ok,
+                                          std::atomic<size_t>& failed)
+    {
+        for (size_t i = 0; i < reads; ++i) {
+            auto item = co_await client->asyncReadDataItem(static_cast<uint32_t>(i % 13));
+            (item ? ok : failed).fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t connections = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    size_t perConnection = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+    size_t reads = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 100;
+
+    spdlog::set_level(spdlog::level::warn);
+    DIManager::preInit();
+
+    auto server = bench::makeTcpServer(bench::port::COROUTINE_READS);
+    for (uint32_t day = 0; day <= 12; ++day) {
+        server->set00(day, 100.0f + static_cast<float>(day));
+    }
+    if (!bench::startTcpServer(*server)) {
+        return 1;
+    }
+
+    // 所有客户端连接共享一个IO线程
+    auto pool = std::make_shared<transport::IoContextPool>(1);
+    pool->run();
+    std::vector<std::shared_ptr<service::ClientService>> clients;
+    for (size_t i = 0; i < connections; ++i) {
+        auto tcpClient = bench::makeTcpClient(bench::port::COROUTINE_READS, perConnection, pool);
+        auto client = std::make_shared<service::ClientService>(tcpClient);
+        if (!client->connect()) {
+            std::fprintf(stderr, "connect %zu failed\n", i);
+            return 1;
+        }
+        clients.push_back(std::move(client));
+    }
+
+    // 所有读取协程在一个线程上运行
+    boost::asio::io_context io(1);
+    std::atomic<size_t> ok { 0 };
+    std::atomic<size_t> failed { 0 };
+    for (auto& client : clients) {
+        for (size_t i = 0; i < perConnection; ++i) {
+            boost::asio::co_spawn(io, readLoop(client, reads, ok, failed), boost::asio::detached);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    io.run();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("connections=%zu coroutines=%zu reads=%zu ok=%zu failed=%zu threads=%d\n",
+                connections,
+                connections * perConnection,
+                ok.load() + failed.load(),
+                ok.load(),
+                failed.load(),
+                threadCount());
+    std::printf("%.0f reads/s\n", static_cast<double>(ok.load()) / seconds);
+
+    for (auto& client : clients) {
+        client->disconnect();
+    }
+    clients.clear();
+    pool->stop();
+    server->stop();
+    return 0;
+}
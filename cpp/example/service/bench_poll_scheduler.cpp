@@ -0,0 +1,87 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include "dlt645/service/poll_scheduler.h"
+#include "dlt645/service/server_service.h"
+#include "dlt645/transport/io_context_pool.h"
+#include "../bench_common.h"
+
+// 轮询调度器基准测试：多个链路上的大量表计按周期轮询，比较计划与实际读取速率
+// 服务端登记全部表计地址（虚拟表计），每个链路为一个TCP连接，链路窗口为1时等同于一条RS-485总线
+// 用法: bench_poll_scheduler [链路数] [每链路表计数] [周期ms] [运行秒数] [链路窗口]
+
+namespace {
+
+    using namespace dlt645;
+    using bench::meterAddress;
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t links = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50;
+    size_t metersPerLink = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+    long intervalMs = argc > 3 ? std::strtol(argv[3], nullptr, 10) : 1000;
+    long seconds = argc > 4 ? std::strtol(argv[4], nullptr, 10) : 5;
+    size_t window = argc > 5 ? std::strtoul(argv[5], nullptr, 10) : 1;
+
+    spdlog::set_level(spdlog::level::warn);
+    DIManager::preInit();
+
+    const std::vector<uint32_t> dis = { 0x00000000, 0x00010000, 0x00020000 };
+
+    auto server = bench::makeTcpServer(bench::port::POLL_SCHEDULER, links * metersPerLink);
+    for (uint32_t di : dis) {
+        server->set00(di, 100.0f);
+    }
+    if (!bench::startTcpServer(*server, links * metersPerLink)) {
+        return 1;
+    }
+
+    // 所有链路共享一个IO线程，调度器另有一个线程
+    auto pool = std::make_shared<transport::IoContextPool>(1);
+    pool->run();
+
+    std::atomic<size_t> batches { 0 };
+    service::PollSchedulerConfig config;
+    auto scheduler = std::make_unique<service::PollScheduler>(config, [&batches](std::vector<service::PollResult>&) { ++batches; });
+    for (size_t l = 0; l < links; ++l) {
+        auto tcpClient = bench::makeTcpClient(bench::port::POLL_SCHEDULER, window, pool);
+        size_t link = scheduler->addLink(tcpClient, window);
+        for (size_t m = 0; m < metersPerLink; ++m) {
+            service::PollTarget target;
+            target.address = meterAddress(1 + l * metersPerLink + m);
+            target.dis = dis;
+            target.interval = std::chrono::milliseconds(intervalMs);
+            scheduler->addMeter(link, target);
+        }
+    }
+
+    if (!scheduler->start()) {
+        std::fprintf(stderr, "failed to start scheduler\n");
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    auto stats = scheduler->stats();
+    scheduler->stop();
+
+    std::printf("links=%zu meters=%zu interval=%ldms window=%zu\n", links, links * metersPerLink, intervalMs, window);
+    std::printf("target %.0f reads/s, achieved %.0f reads/s, ok=%llu failed=%llu skipped=%llu batches=%zu\n",
+                stats.targetRate,
+                stats.achievedRate,
+                static_cast<unsigned long long>(stats.completed),
+                static_cast<unsigned long long>(stats.failed),
+                static_cast<unsigned long long>(stats.skipped),
+                batches.load());
+
+    // 调度器析构时断开各链路，需在IO线程停止前进行
+    scheduler.reset();
+    pool->stop();
+    server->stop();
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <memory>
+#include <poll.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <boost/asio.hpp>
+#include <spdlog/spdlog.h>
+#include "dlt645/service/client_service.h"
+#include "dlt645/service/rtu_bus.h"
+#include "dlt645/service/server_service.h"
+#include "../bench_common.h"
+
+// 多点RTU总线基准测试（两对伪终端背靠背连接模拟一条RS-485总线，不需要串口硬件）
+// RtuServer登记多个虚拟表计地址，主站对每个地址并发读取：
+//   direct      每个表计一个ClientService，共用同一个RtuClient，交换在串口上互相冲突（每表只读1次，失败要等满超时）
+//   bus/threads 每个表计一个RtuBus句柄，每个表计一个线程调用同步接口
+//   bus/coro    每个表计一个RtuBus句柄，所有表计的读取协程在一个线程上运行
+// 伪终端不按波特率限速，wire（按9600波特折算的传输时间占比）会超过100%，在真实串口上不超过100%
+// 用法: bench_rtu_bus [表计数] [每表计读取次数]
+
+namespace {
+
+    using namespace dlt645;
+    using bench::meterAddress;
+
+    int openMaster(std::string& slaveName)
+    {
+        int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0) {
+            return -1;
+        }
+        slaveName = ::ptsname(master);
+        return master;
+    }
+
+    // 在两个伪终端主设备之间双向转发字节，相当于把两个串口接在同一条线上
+    void relay(int a, int b, const std::atomic<bool>& running)
+    {
+        std::array<uint8_t, 512> buffer;
+        pollfd fds[2] = { { a, POLLIN, 0 }, { b, POLLIN, 0 } };
+        while (running) {
+            if (::poll(fds, 2, 50) <= 0) {
+                continue;
+            }
+            for (int i = 0; i < 2; ++i) {
+                if (fds[i].revents & POLLIN) {
+                    ssize_t n = ::read(fds[i].fd, buffer.data(), buffer.size());
+                    if (n > 0 && ::write(fds[1 - i].fd, buffer.data(), static_cast<size_t>(n)) != n) {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    // 每个客户端一个线程，依次读取reads次
+    bench::ReadResult readThreads(const std::vector<std::shared_ptr<service::ClientService>>& clients, size_t reads)
+    {
+        std::atomic<size_t> ok { 0 };
+        std::atomic<size_t> failed { 0 };
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (const auto& client : clients) {
+            threads.emplace_back([&, client]() {
+                for (size_t i = 0; i < reads; ++i) {
+                    (client->read00(0x00000000) ? ok : failed).fetch_add(1);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return { ok.load(), failed.load(), std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+    }
+
+    boost::asio::awaitable<void> readLoop(std::shared_ptr<service::ClientService> client, size_t reads, bench::ReadResult& result)
+    {
+        for (size_t i = 0; i < reads; ++i) {
+            auto item = co_await client->asyncReadDataItem(0x00000000);
+            ++(item ? result.ok : result.failed);
+        }
+    }
+
+    // 所有客户端的读取协程在一个线程上运行
+    bench::ReadResult readCoroutines(const std::vector<std::shared_ptr<service::ClientService>>& clients, size_t reads)
+    {
+        return bench::runCoroutines([&](boost::asio::io_context& io, bench::ReadResult& result) {
+            for (const auto& client : clients) {
+                boost::asio::co_spawn(io, readLoop(client, reads, result), boost::asio::detached);
+            }
+        });
+    }
+
+    void report(const char* name, const bench::ReadResult& result, const service::RtuBusStats* stats)
+    {
+        std::printf("%-12s ok=%zu failed=%zu %.1f reads/s", name, result.ok, result.failed, result.rate());
+        if (stats) {
+            std::printf(" occupancy=%.1f%% wire=%.1f%%", stats->utilization * 100, stats->wireUtilization * 100);
+        }
+        std::printf("\n");
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t meterCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 32;
+    size_t reads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+
+    spdlog::set_level(spdlog::level::off);
+    DIManager::preInit();
+
+    std::string serverPort;
+    std::string clientPort;
+    int serverMaster = openMaster(serverPort);
+    int clientMaster = openMaster(clientPort);
+    if (serverMaster < 0 || clientMaster < 0) {
+        std::perror("posix_openpt");
+        return 1;
+    }
+    std::atomic<bool> running { true };
+    std::thread wire(relay, serverMaster, clientMaster, std::cref(running));
+
+    auto server = service::createRtuServer(serverPort, 9600);
+    server->enableVirtualMeters(meterCount);
+    server->set00(0x00000000, 1234.56f);
+    for (size_t i = 1; i <= meterCount; ++i) {
+        server->addMeter(meterAddress(i));
+    }
+    if (!server->start()) {
+        std::fprintf(stderr, "failed to start RTU server on %s\n", serverPort.c_str());
+        return 1;
+    }
+
+    const auto timeout = std::chrono::milliseconds(200);
+    std::printf("meters=%zu reads/meter=%zu\n", meterCount, reads);
+
+    {
+        // 共用一个RtuClient，每个表计各自的ClientService
+        auto port = std::make_shared<transport::client::RtuClient>();
+        transport::client::RtuClientConfig config;
+        config.port = clientPort;
+        config.baudRate = 9600;
+        config.timeout = timeout;
+        port->configure(config);
+        port->connect(timeout);
+        std::vector<std::shared_ptr<service::ClientService>> clients;
+        for (size_t i = 1; i <= meterCount; ++i) {
+            clients.push_back(std::make_shared<service::ClientService>(port));
+            clients.back()->setAddress(meterAddress(i));
+        }
+        report("direct", readThreads(clients, 1), nullptr);
+        port->disconnect();
+    }
+
+    auto bus = service::RtuBus::createRtuBus(clientPort, 9600, 8, 1, "none", timeout);
+    if (!bus || !bus->connect()) {
+        std::fprintf(stderr, "failed to open RTU bus on %s\n", clientPort.c_str());
+        return 1;
+    }
+    std::vector<std::shared_ptr<service::ClientService>> clients;
+    for (size_t i = 1; i <= meterCount; ++i) {
+        clients.push_back(bus->client(meterAddress(i)));
+    }
+
+    bus->resetStats();
+    auto threaded = readThreads(clients, reads);
+    auto stats = bus->stats();
+    report("bus/threads", threaded, &stats);
+
+    bus->resetStats();
+    auto coroutines = readCoroutines(clients, reads);
+    stats = bus->stats();
+    report("bus/coro", coroutines, &stats);
+
+    clients.clear();
+    bus->disconnect();
+    server->stop();
+    running = false;
+    wire.join();
+    ::close(serverMaster);
+    ::close(clientMaster);
+    return threaded.failed == 0 && coroutines.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include "dlt645/service/client_service.h"
+#include "dlt645/service/server_service.h"
+#include "dlt645/service/tcp_client_pool.h"
+#include "../bench_common.h"
+
+// TCP连接池基准测试：网关中断期间读取被占用的时间
+// 多个线程持续读取，运行中关闭服务端的所有连接并中断一段时间（中断期间端口只监听不接受连接，新连接的SYN被丢弃，
+// 相当于网关重启或网络不通），之后恢复：
+//   direct  每个线程一个ClientService::createTcpClient，连接断开后在读取中同步重连，中断期间每次读取都要等满连接超时
+//   pool    所有线程共用一个TcpClientPool，连接在后台重连，中断期间读取立即失败
+// stall为单次读取的最长耗时，slow/blocked为耗时超过应答超时的读取次数及其耗时之和，recovery为服务端恢复后到第一次读取成功的时间
+// 用法: bench_tcp_client_pool [线程数] [中断ms]
+
+namespace {
+
+    using namespace dlt645;
+    using bench::meterAddress;
+
+    // 只监听不接受连接的端口：backlog为0，占满接受队列后新连接的SYN被丢弃，connect一直等待
+    class Blackhole {
+    public:
+        explicit Blackhole(uint16_t port)
+        {
+            sockaddr_in address {};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            int on = 1;
+            listener_ = ::socket(AF_INET, SOCK_STREAM, 0);
+            ::setsockopt(listener_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+            if (::bind(listener_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener_, 0) != 0) {
+                std::perror("blackhole");
+            }
+            filler_ = ::socket(AF_INET, SOCK_STREAM, 0);
+            if (::connect(filler_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                std::perror("blackhole filler");
+            }
+        }
+
+        ~Blackhole()
+        {
+            ::close(filler_);
+            ::close(listener_);
+        }
+
+    private:
+        int listener_ = -1;
+        int filler_ = -1;
+    };
+
+    struct Result {
+        size_t ok = 0;
+        size_t failed = 0;
+        size_t slow = 0;    // 耗时超过应答超时的读取次数
+        double stall = 0;   // 单次读取最长耗时（秒）
+        double blocked = 0; // 超时读取的耗时之和（秒）
+        double recovery = 0;
+    };
+
+    // 每个客户端一个线程持续读取，运行中中断服务端outage时长
+    Result run(const std::vector<std::shared_ptr<service::ClientService>>& clients,
+               const std::shared_ptr<service::ServerService>& server,
+               std::chrono::milliseconds outage,
+               std::chrono::milliseconds timeout)
+    {
+        using Clock = std::chrono::steady_clock;
+        std::mutex mutex;
+        Result result;
+        std::atomic<bool> running { true };
+        std::atomic<Clock::rep> restored { 0 };
+        std::atomic<Clock::rep> firstOk { 0 };
+
+        std::vector<std::thread> threads;
+        for (const auto& client : clients) {
+            threads.emplace_back([&, client]() {
+                Result local;
+                while (running) {
+                    auto start = Clock::now();
+                    bool ok = client->read00(0x00000000) != nullptr;
+                    auto end = Clock::now();
+                    double seconds = std::chrono::duration<double>(end - start).count();
+                    local.stall = std::max(local.stall, seconds);
+                    if (end - start > timeout) {
+                        ++local.slow;
+                        local.blocked += seconds;
+                    }
+                    if (ok) {
+                        ++local.ok;
+                        auto since = restored.load();
+                        Clock::rep expected = 0;
+                        if (since != 0) {
+                            firstOk.compare_exchange_strong(expected, end.time_since_epoch().count());
+                        }
+                    } else {
+                        ++local.failed;
+                        // 失败时稍作等待，避免空转占满CPU
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                result.ok += local.ok;
+                result.failed += local.failed;
+                result.slow += local.slow;
+                result.stall = std::max(result.stall, local.stall);
+                result.blocked += local.blocked;
+            });
+        }
+
+        // TcpServer::stop不关闭已接受的连接（重新start时才释放），先重启一次让客户端连接被对端关闭，再中断
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        server->stop();
+        server->start();
+        server->stop();
+        {
+            Blackhole blackhole(bench::port::TCP_CLIENT_POOL);
+            std::this_thread::sleep_for(outage);
+        }
+        server->start();
+        restored = Clock::now().time_since_epoch().count();
+        std::this_thread::sleep_for(std::chrono::seconds(3));
+        running = false;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (firstOk != 0) {
+            result.recovery = std::chrono::duration<double>(Clock::duration(firstOk - restored)).count();
+        }
+        return result;
+    }
+
+    void report(const char* name, const Result& result)
+    {
+        std::printf("%-8s ok=%zu failed=%zu slow=%zu stall=%.0fms blocked=%.0fms recovery=%.0fms\n",
+                    name,
+                    result.ok,
+                    result.failed,
+                    result.slow,
+                    result.stall * 1000,
+                    result.blocked * 1000,
+                    result.recovery * 1000);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+    long outageMs = argc > 2 ? std::strtol(argv[2], nullptr, 10) : 1500;
+
+    spdlog::set_level(spdlog::level::off);
+    DIManager::preInit();
+
+    auto server = bench::makeTcpServer(bench::port::TCP_CLIENT_POOL, threads);
+    server->set00(0x00000000, 1234.56f);
+    if (!bench::startTcpServer(*server, threads)) {
+        return 1;
+    }
+
+    const auto timeout = std::chrono::milliseconds(500);
+    const auto outage = std::chrono::milliseconds(outageMs);
+    std::printf("threads=%zu outage=%ldms timeout=%lldms\n", threads, outageMs, static_cast<long long>(timeout.count()));
+
+    {
+        std::vector<std::shared_ptr<service::ClientService>> clients;
+        for (size_t i = 1; i <= threads; ++i) {
+            clients.push_back(service::ClientService::createTcpClient("127.0.0.1", bench::port::TCP_CLIENT_POOL, timeout));
+            clients.back()->setAddress(meterAddress(i));
+            clients.back()->connect();
+        }
+        report("direct", run(clients, server, outage, timeout));
+    }
+
+    service::TcpClientPoolConfig config;
+    config.client.ip = "127.0.0.1";
+    config.client.port = bench::port::TCP_CLIENT_POOL;
+    config.client.timeout = timeout;
+    config.client.maxInFlight = threads;
+    config.size = 4;
+    config.reconnectDelay = std::chrono::milliseconds(100);
+    config.maxReconnectDelay = std::chrono::milliseconds(1000);
+    config.idleTimeout = std::chrono::milliseconds(300);
+    config.probeTimeout = std::chrono::milliseconds(300);
+    auto pool = std::make_shared<service::TcpClientPool>(config);
+    if (!pool->start()) {
+        std::fprintf(stderr, "failed to start connection pool\n");
+        return 1;
+    }
+    std::vector<std::shared_ptr<service::ClientService>> clients;
+    for (size_t i = 1; i <= threads; ++i) {
+        clients.push_back(pool->client(meterAddress(i)));
+    }
+    auto pooled = run(clients, server, outage, timeout);
+    report("pool", pooled);
+    auto stats = pool->stats();
+    std::printf("pool: warm=%zu/%zu requests=%llu rejected=%llu reconnects=%llu connectFailures=%llu\n",
+                stats.warm,
+                stats.size,
+                static_cast<unsigned long long>(stats.requests),
+                static_cast<unsigned long long>(stats.rejected),
+                static_cast<unsigned long long>(stats.reconnects),
+                static_cast<unsigned long long>(stats.connectFailures));
+
+    clients.clear();
+    pool->stop();
+    server->stop();
+    return pooled.ok > 0 && stats.warm == stats.size ? 0 : 1;
+}
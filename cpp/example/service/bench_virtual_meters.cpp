@@ -0,0 +1,73 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <vector>
+#include "dlt645/model/data_item.h"
+#include "dlt645/protocol/protocol.h"
+#include "dlt645/service/server_service.h"
+#include "../bench_common.h"
+
+// 虚拟多表计基准测试：一个ServerService登记大量表计地址，按随机地址处理读电能请求
+// 用法: bench_virtual_meters [表计数] [请求次数]
+
+namespace {
+
+    using namespace dlt645;
+    using bench::meterAddress;
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t meterCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    size_t requests = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+
+    spdlog::set_level(spdlog::level::warn);
+    DIManager::preInit();
+
+    auto service = std::make_shared<service::ServerService>(nullptr, meterAddress(0));
+    service->enableVirtualMeters(meterCount);
+
+    // 每个表计单独写一个电能值，其余DI使用共享值
+    const uint32_t di = 0x00000000;
+    service->set00(di, 1.0f);
+    for (size_t i = 1; i <= meterCount; ++i) {
+        service->addMeter(meterAddress(i));
+        service->set00(meterAddress(i), di, static_cast<float>(i));
+    }
+
+    // 预先编码读请求帧
+    std::mt19937 rng(645);
+    std::uniform_int_distribution<size_t> pick(1, meterCount);
+    std::vector<std::vector<uint8_t>> frames(1024);
+    for (auto& frame : frames) {
+        std::array<uint8_t, 4> data = { 0x00, 0x00, 0x00, 0x00 };
+        frame.resize(protocol::MAX_DATA_LEN + 16);
+        frame.resize(protocol::Frame::encode(frame, meterAddress(pick(rng)), model::CTRL_READ_DATA, data));
+    }
+
+    std::array<uint8_t, protocol::MAX_DATA_LEN + 16> out;
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < requests; ++i) {
+        auto view = protocol::FrameView::parse(frames[i % frames.size()]);
+        bytes += service->handleRequest(*view, out);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // 每表内存与每表值个数及登记表的桶数有关，按本次的表计数计算
+    const size_t bytesPerMeter = service::MeterRegistry(meterCount).bytesPerMeter();
+    std::printf("meters=%zu, bytes/meter=%zu, total=%.1f MB\n",
+                service->meterCount(),
+                bytesPerMeter,
+                static_cast<double>(bytesPerMeter * meterCount) / (1024 * 1024));
+    std::printf("requests=%zu, %.0f ns/request, %zu bytes\n",
+                requests,
+                std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(requests),
+                bytes);
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+#include <spdlog/spdlog.h>
+#include "dlt645/service/client_service.h"
+#include "dlt645/service/device_health.h"
+#include "../bench_common.h"
+
+// 设备健康测试：向掉线表计发出一批流水线请求，熔断只在跨过阈值时发生一次，
+// 熔断前已在途的请求晚到的失败不再延长熔断时长，探测期间晚到的旧结果被忽略；
+// 通过不应答的TCP链路批量读取时，熔断后还在窗口外排队的请求不再发出
+// 全部通过时返回0
+
+namespace {
+
+    using dlt645::service::CircuitState;
+    using dlt645::service::DeviceHealth;
+    using dlt645::service::DeviceHealthConfig;
+    using boost::asio::ip::tcp;
+    using namespace std::chrono_literals;
+
+    int failures = 0;
+
+    void check(bool ok, const char* name)
+    {
+        std::printf("%-40s %s\n", name, ok ? "通过" : "失败");
+        if (!ok) {
+            ++failures;
+        }
+    }
+
+    // 正常状态下一次放行count个请求（流水线窗口内同时在途）
+    std::vector<DeviceHealth::Ticket> admitBatch(DeviceHealth& health, size_t count, std::chrono::steady_clock::time_point now)
+    {
+        std::vector<DeviceHealth::Ticket> tickets;
+        for (size_t i = 0; i < count; ++i) {
+            if (auto ticket = health.acquire(now)) {
+                tickets.push_back(*ticket);
+            }
+        }
+        return tickets;
+    }
+
+    // 模拟掉线表计的链路：接受连接，读取并丢弃所有请求，从不应答
+    void swallow(const std::shared_ptr<tcp::socket>& socket, const std::shared_ptr<std::array<uint8_t, 256>>& buffer)
+    {
+        socket->async_read_some(boost::asio::buffer(*buffer), [socket, buffer](auto error, size_t) {
+            if (!error) {
+                swallow(socket, buffer);
+            }
+        });
+    }
+
+    void accept(tcp::acceptor& acceptor)
+    {
+        acceptor.async_accept([&acceptor](auto error, tcp::socket socket) {
+            if (error) {
+                return;
+            }
+            swallow(std::make_shared<tcp::socket>(std::move(socket)), std::make_shared<std::array<uint8_t, 256>>());
+            accept(acceptor);
+        });
+    }
+
+} // namespace
+
+int main()
+{
+    spdlog::set_level(spdlog::level::off);
+
+    DeviceHealthConfig config;
+    config.failureThreshold = 3;
+    config.openDuration = 1s;
+    const auto start = std::chrono::steady_clock::now();
+
+    // 一批10个请求在正常状态下放行，随后全部超时
+    {
+        DeviceHealth health(config);
+        auto tickets = admitBatch(health, 10, start);
+        check(tickets.size() == 10, "流水线：正常状态下全部放行");
+        auto now = start + 100ms;
+        for (const auto& ticket : tickets) {
+            health.onFailure(ticket, now);
+        }
+        auto stats = health.stats();
+        check(stats.state == CircuitState::Open && stats.opens == 1, "流水线：只熔断一次");
+        check(stats.openUntil == now + 1s, "流水线：熔断时长为openDuration");
+        check(stats.failures == 10, "流水线：晚到的失败计入统计");
+        check(!health.acquire(now + 999ms), "流水线：熔断期间拒绝请求");
+        check(health.acquire(now + 1s).has_value(), "流水线：熔断时长到后放行探测");
+    }
+
+    // 探测期间晚到的旧结果不改变状态，探测失败后熔断时长翻倍
+    {
+        DeviceHealth health(config);
+        auto tickets = admitBatch(health, 5, start);
+        for (size_t i = 0; i < 3; ++i) {
+            health.onFailure(tickets[i], start);
+        }
+        auto probe = health.acquire(start + 1s);
+        check(probe.has_value() && health.stats().state == CircuitState::HalfOpen, "探测：进入半开状态");
+        health.onFailure(tickets[3], start + 1s);
+        health.onSuccess(tickets[4], 10ms);
+        check(health.stats().state == CircuitState::HalfOpen, "探测：忽略熔断前请求的结果");
+        check(!health.acquire(start + 1s), "探测：探测结束前拒绝其他请求");
+        health.onFailure(*probe, start + 2s);
+        auto stats = health.stats();
+        check(stats.state == CircuitState::Open && stats.opens == 2 && stats.openUntil == start + 4s, "探测：探测失败后熔断时长翻倍");
+
+        // 第二次探测成功，恢复正常
+        auto second = health.acquire(start + 4s);
+        check(second.has_value(), "恢复：熔断时长到后再次探测");
+        health.onSuccess(*second, 10ms);
+        stats = health.stats();
+        check(stats.state == CircuitState::Closed && stats.opens == 0 && stats.consecutiveFailures == 0, "恢复：探测成功后恢复正常");
+
+        // 恢复后旧凭据的失败不计入连续失败
+        health.onFailure(*probe, start + 4s);
+        check(health.stats().consecutiveFailures == 0, "恢复：忽略旧凭据的失败");
+    }
+
+    // 排队期间熔断：放行时正常，发出前已熔断的请求不放行；熔断时长到后排队的请求作为探测放行
+    {
+        DeviceHealth health(config);
+        auto tickets = admitBatch(health, 5, start);
+        for (size_t i = 0; i < 3; ++i) {
+            health.onFailure(tickets[i], start);
+        }
+        check(!health.admit(tickets[3], start + 500ms), "排队：熔断后不再发出");
+        check(health.admit(tickets[4], start + 1s) && health.stats().state == CircuitState::HalfOpen, "排队：熔断时长到后作为探测发出");
+        health.onSuccess(tickets[4], 10ms);
+        check(health.stats().state == CircuitState::Closed, "排队：探测成功后恢复正常");
+    }
+
+    // 通过不应答的链路批量读取：窗口为1，前failureThreshold个请求超时后熔断，其余请求不再占用链路
+    {
+        boost::asio::io_context io;
+        tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), dlt645::bench::port::DEVICE_HEALTH));
+        accept(acceptor);
+        std::thread link([&io]() { io.run(); });
+
+        auto connection = dlt645::bench::makeTcpClient(dlt645::bench::port::DEVICE_HEALTH);
+        dlt645::service::ClientService client(connection);
+        DeviceHealthConfig deadConfig = config;
+        deadConfig.initialTimeout = 100ms;
+        deadConfig.minTimeout = 100ms;
+        deadConfig.maxTimeout = 100ms;
+        client.setHealthConfig(deadConfig);
+
+        std::vector<uint32_t> dis(10, 0x00000000);
+        auto begin = std::chrono::steady_clock::now();
+        auto results = client.readMany(dis);
+        auto elapsed = std::chrono::steady_clock::now() - begin;
+        auto stats = client.health();
+        check(std::ranges::all_of(results, [](const auto& item) { return !item; }), "批量读取：全部失败");
+        check(stats.failures == deadConfig.failureThreshold && stats.rejected == dis.size() - deadConfig.failureThreshold,
+              "批量读取：熔断后排队的请求不再发出");
+        check(stats.state == CircuitState::Open && stats.opens == 1, "批量读取：只熔断一次");
+        check(elapsed < 100ms * dis.size() / 2, "批量读取：不为排队的请求等满超时");
+
+        client.disconnect();
+        io.stop();
+        link.join();
+    }
+
+    std::printf("%s\n", failures == 0 ? "全部通过" : "存在失败的用例");
+    return failures == 0 ? 0 : 1;
+}
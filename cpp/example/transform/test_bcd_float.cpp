@@ -1,3 +1,4 @@
+#include <array>
 #include <cstdio>
 #include <iostream>
 #include <vector>
@@ -13,5 +14,15 @@ int main()
     // 使用原函数转换
     float result = dlt645::common::bcdToFloat(bcdData, dataFormat, false);
     std::printf("原始函数结果: %f\n", result);
+
+    // 使用预编译的格式描述符转换，直接得到缩放后的整数
+    auto format = dlt645::common::BcdFormat::parse(dataFormat);
+    auto scaled = dlt645::common::decodeBcd(bcdData, format, false);
+    std::printf("格式描述符结果: %lld (小数位数: %d)\n", static_cast<long long>(scaled.value_or(0)), format.decimals);
+
+    // 反向编码
+    std::array<uint8_t, 4> encoded = { 0 };
+    dlt645::common::floatToBcd(result, format, encoded, false);
+    std::printf("编码结果: %02X %02X %02X %02X\n", encoded[0], encoded[1], encoded[2], encoded[3]);
     return 0;
 }
\ No newline at end of file
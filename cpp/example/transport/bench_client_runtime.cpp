@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dlt645/common/log.h"
+#include "dlt645/service/client_service.h"
+#include "dlt645/service/server_service.h"
+#include "dlt645/transport/io_context_pool.h"
+#include "../bench_common.h"
+
+// 客户端共享io_context池基准测试：大量ClientService连接同一个服务端，
+// 对比每个连接独占IO线程与共享固定大小io_context池时的进程线程数，并逐个读取一次电能
+// 用法: bench_client_runtime [连接数] [池线程数]
+
+namespace {
+
+    using namespace dlt645;
+
+    // 当前进程的线程数
+    int threadCount()
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.rfind("Threads:", 0) == 0) {
+                return std::atoi(line.c_str() + 8);
+            }
+        }
+        return -1;
+    }
+
+    void runRound(const char* label, size_t clients, std::shared_ptr<transport::IoContextPool> pool)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::shared_ptr<service::ClientService>> services;
+        services.reserve(clients);
+        size_t connected = 0;
+        for (size_t i = 0; i < clients; ++i) {
+            auto client = service::ClientService::createTcpClient("127.0.0.1", bench::port::CLIENT_RUNTIME, std::chrono::seconds(5), pool);
+            connected += client->connect() ? 1 : 0;
+            services.push_back(std::move(client));
+        }
+        int threads = threadCount();
+
+        size_t ok = 0;
+        for (auto& client : services) {
+            ok += client->read00(0x00000000) ? 1 : 0;
+        }
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-16s clients=%zu connected=%zu reads=%zu threads=%d time=%.0f ms\n",
+                    label, clients, connected, ok, threads, elapsed);
+        services.clear();
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t clients = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    size_t poolThreads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2;
+
+    spdlog::set_level(spdlog::level::warn);
+
+    auto tcpServer = std::make_shared<transport::server::TcpServer>();
+    transport::server::TcpServerConfig config;
+    config.ip = "127.0.0.1";
+    config.port = bench::port::CLIENT_RUNTIME;
+    config.maxConnections = 0;
+    tcpServer->configure(config);
+    auto server = std::make_shared<service::ServerService>(tcpServer);
+    server->init();
+    server->set00(0x00000000, 1234.56f);
+    if (!server->start()) {
+        std::fprintf(stderr, "failed to start server\n");
+        return 1;
+    }
+
+    runRound("private threads", clients, nullptr);
+
+    auto pool = std::make_shared<transport::IoContextPool>(poolThreads);
+    pool->run();
+    runRound("shared pool", clients, pool);
+    pool->stop();
+
+    server->stop();
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+#include "dlt645/common/log.h"
+#include "dlt645/model/model.h"
+#include "dlt645/protocol/protocol.h"
+#include "dlt645/service/server_service.h"
+#include "../bench_common.h"
+
+// 重连风暴基准测试：模拟网关重启后大量电表同时重连
+// 每轮由多个客户端线程同时建立全部连接，每个连接完成一次读电能请求后保持，全部完成后统一断开
+// 分别测试单acceptor与SO_REUSEPORT多acceptor两种模式下一轮风暴的耗时
+// 用法: bench_reconnect_storm [每轮连接数] [轮数] [IO线程数] [客户端线程数]
+
+namespace {
+
+    using namespace dlt645;
+    using boost::asio::ip::tcp;
+
+    // 建立count个连接，每个连接完成一次请求/响应；返回成功的连接（由调用方统一关闭）
+    std::vector<std::unique_ptr<tcp::socket>> connectBatch(boost::asio::io_context& io, int count, const std::vector<uint8_t>& request)
+    {
+        std::vector<std::unique_ptr<tcp::socket>> sockets;
+        tcp::endpoint endpoint(boost::asio::ip::make_address("127.0.0.1"), bench::port::RECONNECT_STORM);
+        std::array<uint8_t, 512> buffer;
+        for (int i = 0; i < count; ++i) {
+            auto socket = std::make_unique<tcp::socket>(io);
+            boost::system::error_code ec;
+            socket->connect(endpoint, ec);
+            if (!ec) {
+                boost::asio::write(*socket, boost::asio::buffer(request), ec);
+            }
+            protocol::FrameDecoder decoder;
+            size_t frames = 0;
+            while (!ec && frames == 0) {
+                size_t n = socket->read_some(boost::asio::buffer(buffer), ec);
+                frames = decoder.feed(std::span<const uint8_t>(buffer.data(), n), [](const protocol::FrameView&) {});
+            }
+            if (!ec) {
+                sockets.push_back(std::move(socket));
+            }
+        }
+        return sockets;
+    }
+
+    void runMode(bool reusePort, int connections, int rounds, int ioThreads, int clientThreads, const std::vector<uint8_t>& request)
+    {
+        auto tcpServer = std::make_shared<transport::server::TcpServer>();
+        transport::server::TcpServerConfig config;
+        config.ip = "127.0.0.1";
+        config.port = bench::port::RECONNECT_STORM;
+        config.maxConnections = connections;
+        config.ioThreads = ioThreads;
+        config.reusePort = reusePort;
+        tcpServer->configure(config);
+
+        auto server = std::make_shared<service::ServerService>(tcpServer);
+        server->init();
+        server->set00(0x00000000, 1234.56f);
+        if (!server->start()) {
+            std::printf("%-12s failed to start\n", reusePort ? "reuseport" : "single");
+            return;
+        }
+
+        double totalMs = 0.0;
+        double worstMs = 0.0;
+        size_t established = 0;
+        for (int round = 0; round < rounds; ++round) {
+            std::atomic<size_t> ok { 0 };
+            std::vector<std::thread> clients;
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::vector<std::unique_ptr<tcp::socket>>> held(clientThreads);
+            std::vector<std::unique_ptr<boost::asio::io_context>> contexts;
+            for (int t = 0; t < clientThreads; ++t) {
+                contexts.push_back(std::make_unique<boost::asio::io_context>());
+            }
+            for (int t = 0; t < clientThreads; ++t) {
+                int count = connections / clientThreads + (t < connections % clientThreads ? 1 : 0);
+                clients.emplace_back([&, t, count] {
+                    held[t] = connectBatch(*contexts[t], count, request);
+                    ok.fetch_add(held[t].size());
+                });
+            }
+            for (auto& client : clients) {
+                client.join();
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            totalMs += ms;
+            worstMs = std::max(worstMs, ms);
+            established += ok.load();
+
+            // 统一断开，等待服务端回收后再开始下一轮
+            held.clear();
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+        server->stop();
+
+        double avgMs = totalMs / rounds;
+        std::printf("%-12s %10zu %12.1f %12.1f %14.0f\n",
+                    reusePort ? "reuseport" : "single",
+                    established / static_cast<size_t>(rounds),
+                    avgMs,
+                    worstMs,
+                    static_cast<double>(connections) * 1000.0 / avgMs);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int connections = argc > 1 ? std::atoi(argv[1]) : 500;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+    int ioThreads = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int clientThreads = argc > 4 ? std::atoi(argv[4]) : 16;
+
+    // 每个请求都会记录收发日志，基准测试中只保留警告以上级别
+    spdlog::set_level(spdlog::level::warn);
+
+    std::array<uint8_t, 6> address = { 0 };
+    std::vector<uint8_t> request = protocol::Frame::buildFrame(address, model::CTRL_READ_DATA, { 0x00, 0x00, 0x00, 0x00 });
+
+    std::printf("connections/round=%d, rounds=%d, io threads=%d, client threads=%d\n", connections, rounds, ioThreads, clientThreads);
+    std::printf("%-12s %10s %12s %12s %14s\n", "acceptors", "connected", "avg ms", "worst ms", "conns/s");
+    runMode(false, connections, rounds, ioThreads, clientThreads, request);
+    runMode(true, connections, rounds, ioThreads, clientThreads, request);
+    return 0;
+}
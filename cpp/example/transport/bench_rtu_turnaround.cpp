@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <poll.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "dlt645/common/log.h"
+#include "dlt645/model/model.h"
+#include "dlt645/protocol/protocol.h"
+#include "dlt645/service/server_service.h"
+#include "dlt645/transport/rtu_timing.h"
+
+// RTU服务端应答时间基准测试（伪终端回环，不需要串口硬件）
+// 主站一端为伪终端主设备，RtuServer打开从设备；统计从写完请求到收齐响应帧的时间
+// 服务端按9600 8N1在收到请求后等待收发切换间隔（4个字符时间，约4.2ms）再应答，应答时间应略高于该间隔
+// 另外验证：一次写入多个请求时响应按序全部返回；半帧在字符间超时后被丢弃，不影响下一帧
+// 用法: bench_rtu_turnaround [请求次数]
+
+namespace {
+
+    using namespace dlt645;
+
+    // 从主设备读取，直到解出expected个帧或超时，返回解出的帧数
+    size_t readFrames(int fd, protocol::FrameDecoder& decoder, size_t expected, std::chrono::milliseconds timeout)
+    {
+        std::array<uint8_t, 512> buffer;
+        size_t frames = 0;
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (frames < expected) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (left.count() <= 0) {
+                break;
+            }
+            pollfd pfd { fd, POLLIN, 0 };
+            if (::poll(&pfd, 1, static_cast<int>(left.count())) <= 0) {
+                continue;
+            }
+            ssize_t n = ::read(fd, buffer.data(), buffer.size());
+            if (n <= 0) {
+                break;
+            }
+            frames += decoder.feed(std::span<const uint8_t>(buffer.data(), static_cast<size_t>(n)),
+                                   [](const protocol::FrameView&) {});
+        }
+        return frames;
+    }
+
+    bool writeAll(int fd, std::span<const uint8_t> data)
+    {
+        while (!data.empty()) {
+            ssize_t n = ::write(fd, data.data(), data.size());
+            if (n <= 0) {
+                return false;
+            }
+            data = data.subspan(static_cast<size_t>(n));
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t requests = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500;
+
+    spdlog::set_level(spdlog::level::warn);
+
+    // 打开伪终端
+    int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0) {
+        std::perror("posix_openpt");
+        return 1;
+    }
+    const char* slaveName = ::ptsname(master);
+
+    auto server = service::createRtuServer(slaveName, 9600);
+    if (!server || !server->start()) {
+        std::fprintf(stderr, "failed to start RTU server on %s\n", slaveName);
+        return 1;
+    }
+    server->set00(0x00000000, 1234.56f);
+
+    // 读电能请求帧
+    const std::array<uint8_t, 6> address = server->getAddress();
+    const std::array<uint8_t, 4> di = { 0x00, 0x00, 0x00, 0x00 };
+    std::array<uint8_t, protocol::MAX_ENCODED_LEN> request;
+    size_t requestLen = protocol::Frame::encode(request, address, model::CTRL_READ_DATA, di);
+    std::span<const uint8_t> frame(request.data(), requestLen);
+
+    protocol::FrameDecoder decoder;
+    std::vector<double> samples;
+    samples.reserve(requests);
+    for (size_t i = 0; i < requests; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        if (!writeAll(master, frame) || readFrames(master, decoder, 1, std::chrono::seconds(1)) != 1) {
+            std::fprintf(stderr, "request %zu: no response\n", i);
+            return 1;
+        }
+        samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double s : samples) {
+        sum += s;
+    }
+    const double delay = std::chrono::duration<double, std::micro>(transport::RtuTiming().turnaround({})).count();
+    std::printf("turnaround delay: %.1f us\n", delay);
+    std::printf("turnaround: requests=%zu avg=%.1f us p50=%.1f us p99=%.1f us max=%.1f us\n",
+                requests,
+                sum / static_cast<double>(samples.size()),
+                samples[samples.size() / 2],
+                samples[samples.size() * 99 / 100],
+                samples.back());
+
+    // 一次写入多个请求，响应经发送队列按序全部返回
+    constexpr size_t BURST = 32;
+    std::vector<uint8_t> burst;
+    for (size_t i = 0; i < BURST; ++i) {
+        burst.insert(burst.end(), frame.begin(), frame.end());
+    }
+    writeAll(master, burst);
+    size_t burstFrames = readFrames(master, decoder, BURST, std::chrono::seconds(2));
+    std::printf("burst: %zu/%zu responses\n", burstFrames, BURST);
+
+    // 半帧后停顿超过字符间超时，再发完整帧：半帧被丢弃，完整帧正常应答
+    writeAll(master, frame.first(frame.size() / 2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    writeAll(master, frame);
+    size_t recovered = readFrames(master, decoder, 1, std::chrono::seconds(1));
+    std::printf("partial frame recovery: %s\n", recovered == 1 ? "ok" : "failed");
+
+    server->stop();
+    ::close(master);
+    return burstFrames == BURST && recovered == 1 ? 0 : 1;
+}
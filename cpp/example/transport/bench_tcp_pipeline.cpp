@@ -0,0 +1,150 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+#include "dlt645/common/log.h"
+#include "dlt645/protocol/protocol.h"
+#include "dlt645/service/client_service.h"
+#include "dlt645/service/server_service.h"
+#include "../bench_common.h"
+
+// TCP客户端流水线基准测试：模拟往返时延固定的DTU/网关链路，对比不同流水线窗口下的读取速率
+// 模拟网关对每个请求延迟RTT后应答（各请求独立计时，不互相排队），客户端用readMany批量读取
+// 用法: bench_tcp_pipeline [RTT毫秒] [每轮读取数]
+
+namespace {
+
+    using namespace dlt645;
+    using boost::asio::ip::tcp;
+
+    // 模拟网关的一个连接：解出请求帧，延迟RTT后按到达顺序写回响应
+    class DelayedSession : public std::enable_shared_from_this<DelayedSession> {
+    public:
+        DelayedSession(tcp::socket socket, std::shared_ptr<service::ServerService> meter, std::chrono::milliseconds rtt)
+            : socket_(std::move(socket))
+            , meter_(std::move(meter))
+            , rtt_(rtt)
+        {
+        }
+
+        void start() { read(); }
+
+    private:
+        void read()
+        {
+            socket_.async_read_some(boost::asio::buffer(buffer_), [self = shared_from_this()](auto error, size_t n) {
+                if (error) {
+                    return;
+                }
+                self->decoder_.feed(std::span<const uint8_t>(self->buffer_.data(), n),
+                                    [&self](const protocol::FrameView& frame) { self->respondLater(frame); });
+                self->read();
+            });
+        }
+
+        void respondLater(const protocol::FrameView& frame)
+        {
+            auto response = std::make_shared<std::vector<uint8_t>>(protocol::MAX_ENCODED_LEN);
+            response->resize(meter_->handleRequest(frame, *response));
+            auto timer = std::make_shared<boost::asio::steady_timer>(socket_.get_executor(), rtt_);
+            timer->async_wait([self = shared_from_this(), timer, response](auto) {
+                self->outbox_.push_back(std::move(*response));
+                self->write();
+            });
+        }
+
+        void write()
+        {
+            if (writing_ || outbox_.empty()) {
+                return;
+            }
+            writing_ = true;
+            boost::asio::async_write(socket_, boost::asio::buffer(outbox_.front()), [self = shared_from_this()](auto error, size_t) {
+                self->writing_ = false;
+                self->outbox_.pop_front();
+                if (!error) {
+                    self->write();
+                }
+            });
+        }
+
+        tcp::socket socket_;
+        std::shared_ptr<service::ServerService> meter_;
+        std::chrono::milliseconds rtt_;
+        std::array<uint8_t, 1024> buffer_;
+        protocol::FrameDecoder decoder_;
+        std::deque<std::vector<uint8_t>> outbox_;
+        bool writing_ = false;
+    };
+
+    void accept(tcp::acceptor& acceptor, std::shared_ptr<service::ServerService> meter, std::chrono::milliseconds rtt)
+    {
+        acceptor.async_accept([&acceptor, meter, rtt](auto error, tcp::socket socket) {
+            if (error) {
+                return;
+            }
+            std::make_shared<DelayedSession>(std::move(socket), meter, rtt)->start();
+            accept(acceptor, meter, rtt);
+        });
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::chrono::milliseconds rtt(argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200);
+    size_t reads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+
+    spdlog::set_level(spdlog::level::warn);
+    DIManager::preInit();
+
+    // 电表数据由不带传输层的ServerService生成
+    auto meter = std::make_shared<service::ServerService>(nullptr);
+    for (uint32_t day = 0; day <= 12; ++day) {
+        meter->set00(day, 100.0f + static_cast<float>(day));
+    }
+
+    boost::asio::io_context io;
+    tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), bench::port::TCP_PIPELINE));
+    accept(acceptor, meter, rtt);
+    std::thread gateway([&io]() { io.run(); });
+
+    // 组合有功总电能（当前及上1~12结算日）
+    std::vector<uint32_t> dis(reads);
+    for (size_t i = 0; i < reads; ++i) {
+        dis[i] = static_cast<uint32_t>(i % 13);
+    }
+
+    std::printf("rtt=%lld ms, reads per round=%zu\n", static_cast<long long>(rtt.count()), reads);
+    std::printf("%8s %12s %10s\n", "window", "reads/s", "ok");
+    for (size_t window : { 1, 4, 16, 64 }) {
+        auto tcpClient = std::make_shared<transport::client::TcpClient>();
+        transport::client::TcpClientConfig config;
+        config.ip = "127.0.0.1";
+        config.port = bench::port::TCP_PIPELINE;
+        config.maxInFlight = window;
+        tcpClient->configure(config);
+        service::ClientService client(tcpClient);
+
+        auto start = std::chrono::steady_clock::now();
+        auto results = client.readMany(dis);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t ok = 0;
+        for (size_t i = 0; i < results.size(); ++i) {
+            // 响应必须与请求的DI对应
+            ok += results[i] && results[i]->di == dis[i] ? 1 : 0;
+        }
+        std::printf("%8zu %12.1f %7zu/%zu\n", window, static_cast<double>(reads) / seconds, ok, reads);
+        client.disconnect();
+    }
+
+    io.stop();
+    gateway.join();
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+#include "dlt645/common/log.h"
+#include "dlt645/model/model.h"
+#include "dlt645/protocol/protocol.h"
+#include "dlt645/service/server_service.h"
+#include "../bench_common.h"
+
+// TCP服务端吞吐量随IO线程数变化的基准测试
+// 每个客户端连接在独立线程中循环发送读电能请求并等待响应（一问一答），统计服务端每秒处理的请求数
+// 用法: bench_tcp_server [连接数] [每组测试秒数] [最大IO线程数]
+
+namespace {
+
+    using namespace dlt645;
+    using boost::asio::ip::tcp;
+
+    // 单个客户端连接：发送请求、解出完整响应帧后再发下一个
+    void runClient(const std::vector<uint8_t>& request, const std::atomic<bool>& stop, std::atomic<uint64_t>& completed)
+    {
+        boost::asio::io_context io;
+        tcp::socket socket(io);
+        socket.connect(tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), bench::port::TCP_SERVER));
+        socket.set_option(tcp::no_delay(true));
+
+        protocol::FrameDecoder decoder;
+        std::array<uint8_t, 512> buffer;
+        uint64_t count = 0;
+        boost::system::error_code ec;
+        while (!stop.load(std::memory_order_relaxed)) {
+            boost::asio::write(socket, boost::asio::buffer(request), ec);
+            size_t frames = 0;
+            while (!ec && frames == 0) {
+                size_t n = socket.read_some(boost::asio::buffer(buffer), ec);
+                frames = decoder.feed(std::span<const uint8_t>(buffer.data(), n), [](const protocol::FrameView&) {});
+            }
+            if (ec) {
+                break;
+            }
+            ++count;
+        }
+        completed.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    double runRound(int ioThreads, int connections, std::chrono::seconds duration, const std::vector<uint8_t>& request)
+    {
+        auto tcpServer = std::make_shared<transport::server::TcpServer>();
+        transport::server::TcpServerConfig config;
+        config.ip = "127.0.0.1";
+        config.port = bench::port::TCP_SERVER;
+        config.maxConnections = connections;
+        config.ioThreads = ioThreads;
+        tcpServer->configure(config);
+
+        auto server = std::make_shared<service::ServerService>(tcpServer);
+        server->init();
+        server->set00(0x00000000, 1234.56f);
+        if (!server->start()) {
+            return 0.0;
+        }
+
+        std::atomic<bool> stop { false };
+        std::atomic<uint64_t> completed { 0 };
+        std::vector<std::thread> clients;
+        for (int i = 0; i < connections; ++i) {
+            clients.emplace_back([&] { runClient(request, stop, completed); });
+        }
+
+        std::this_thread::sleep_for(duration);
+        stop = true;
+        for (auto& client : clients) {
+            client.join();
+        }
+        server->stop();
+
+        return static_cast<double>(completed.load()) / static_cast<double>(duration.count());
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int connections = argc > 1 ? std::atoi(argv[1]) : 64;
+    std::chrono::seconds duration(argc > 2 ? std::atoi(argv[2]) : 3);
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    // 每个请求都会记录收发日志，基准测试中只保留警告以上级别
+    spdlog::set_level(spdlog::level::warn);
+
+    std::array<uint8_t, 6> address = { 0 };
+    std::vector<uint8_t> request = protocol::Frame::buildFrame(address, model::CTRL_READ_DATA, { 0x00, 0x00, 0x00, 0x00 });
+
+    std::printf("connections=%d, duration=%llds\n", connections, static_cast<long long>(duration.count()));
+    std::printf("%-10s %14s %10s\n", "threads", "requests/s", "speedup");
+
+    double baseline = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double rate = runRound(threads, connections, duration, request);
+        if (threads == 1) {
+            baseline = rate;
+        }
+        std::printf("%-10d %14.0f %9.2fx\n", threads, rate, baseline > 0.0 ? rate / baseline : 0.0);
+    }
+
+    return 0;
+}
@@ -10,8 +10,10 @@
 #include <iomanip>
 #include <limits>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -19,7 +21,7 @@ namespace dlt645 {
     namespace common {
 
         // 字节数组转十六进制字符串
-        std::string bytesToHexString(const std::vector<uint8_t>& bytes, bool uppercase = true, bool withSpace = true);
+        std::string bytesToHexString(std::span<const uint8_t> bytes, bool uppercase = true, bool withSpace = true);
 
         // 十六进制字符串转字节数组
         std::optional<std::vector<uint8_t>> hexStringToBytes(const std::string& hex);
@@ -36,7 +38,80 @@ namespace dlt645 {
         // 从BCD码转换为整数
         uint32_t bcdToInt(const std::vector<uint8_t>& bcd);
 
-        // 将浮点数转换为BCD码（根据数据格式）
+        // BCD数值格式描述符，由"XXXXXX.XX"这类格式串预编译得到，编解码时不再解析格式串
+        struct BcdFormat {
+            inline constexpr static uint8_t MAX_DIGITS = 18; // int64_t可精确表示的十进制位数
+
+            uint8_t byteWidth = 0; // BCD字节数
+            uint8_t digits = 0;    // 十进制位数
+            uint8_t decimals = 0;  // 小数位数
+            bool isSigned = false; // 最高字节的最高位是否为符号位
+            int64_t maxScaled = 0; // 缩放后整数允许的最大绝对值
+
+            // 解析格式串：'.'之外的每个字符为一位数字，'.'之后的位数为小数位数
+            static constexpr BcdFormat parse(std::string_view format, bool isSigned = true)
+            {
+                BcdFormat result;
+                size_t dot = format.find('.');
+                size_t digits = format.size() - (dot == std::string_view::npos ? 0 : 1);
+                digits = std::min<size_t>(digits, MAX_DIGITS);
+                result.digits = static_cast<uint8_t>(digits);
+                result.decimals = static_cast<uint8_t>(dot == std::string_view::npos ? 0 : format.size() - dot - 1);
+                result.byteWidth = static_cast<uint8_t>((digits + 1) / 2);
+                result.isSigned = isSigned;
+
+                // 有符号且位数为偶数时，最高位数字与符号位共用一个半字节，最大只能到7
+                int64_t limit = pow10(result.digits);
+                result.maxScaled = (isSigned && digits % 2 == 0 && digits > 0) ? limit / 10 * 8 - 1 : limit - 1;
+                return result;
+            }
+
+            // 10的n次方
+            static constexpr int64_t pow10(uint8_t n)
+            {
+                int64_t value = 1;
+                for (uint8_t i = 0; i < n; ++i) {
+                    value *= 10;
+                }
+                return value;
+            }
+
+            // 缩放因子（10^decimals）
+            constexpr int64_t scaleFactor() const { return pow10(decimals); }
+
+            // 缩放后的整数是否在格式范围内
+            constexpr bool inRange(int64_t scaled) const
+            {
+                return scaled <= maxScaled && scaled >= (isSigned ? -maxScaled : 0);
+            }
+
+            // 浮点数转换为缩放后的整数（四舍五入）
+            int64_t toScaled(double value) const
+            {
+                return static_cast<int64_t>(std::llround(value * static_cast<double>(scaleFactor())));
+            }
+
+            // 缩放后的整数转换为浮点数
+            double fromScaled(int64_t scaled) const
+            {
+                return static_cast<double>(scaled) / static_cast<double>(scaleFactor());
+            }
+        };
+
+        // 将缩放后的整数按格式写入out，返回写入的字节数（format.byteWidth），超出范围或out空间不足时返回0
+        size_t encodeBcd(int64_t scaled, const BcdFormat& format, std::span<uint8_t> out, bool littleEndian = true);
+
+        // 按格式解析BCD码（解析bcd中的全部字节），返回缩放后的整数，BCD码无效时返回std::nullopt
+        std::optional<int64_t> decodeBcd(std::span<const uint8_t> bcd, const BcdFormat& format, bool littleEndian = true);
+
+        // 将浮点数按格式转换为BCD码写入out，返回写入的字节数，失败时返回0
+        size_t floatToBcd(float value, const BcdFormat& format, std::span<uint8_t> out, bool littleEndian = true);
+
+        // 按格式将BCD码转换为浮点数，BCD码无效时返回0
+        float bcdToFloat(std::span<const uint8_t> bcd, const BcdFormat& format, bool littleEndian = true);
+
+        // 将浮点数转换为BCD码（根据数据格式），输出格式宽度的字节；
+        // 超出格式范围时与原实现一样输出全部数字，字节数大于格式宽度，超出int64_t可表示的范围时返回空
         std::vector<uint8_t> floatToBcd(float value, const std::string& dataFormat, bool littleEndian = true);
         // BCD码转换为浮点数（根据数据格式）
         float bcdToFloat(const std::vector<uint8_t>& bcd, const std::string& dataFormat, bool littleEndian = true);
@@ -57,7 +132,7 @@ namespace dlt645 {
 
         // 将小端序的字节数组转换为整数
         template <typename T = uint32_t>
-        T bytesToIntLittleEndian(const std::vector<uint8_t>& bytes)
+        T bytesToIntLittleEndian(std::span<const uint8_t> bytes)
         {
             T result = 0;
 
@@ -1,13 +1,20 @@
 #ifndef DLT645_DATA_ITEM_H
 #define DLT645_DATA_ITEM_H
 
+#include "di_index.h"
 #include "model.h"
 #include "util/singleton.hpp"
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace dlt645 {
@@ -18,7 +25,7 @@ namespace dlt645 {
         public:
             uint32_t di = 0;                                                                   // 数据项地址
             std::string name;                                                                  // 数据名称
-            std::string dataFormat;                                                            // 数据格式
+            DataFormat dataFormat = DataFormat::Unknown;                                       // 数据格式
             std::variant<std::monostate, float, int32_t, uint32_t, std::string, Demand> value; // 实际值
             std::string unit;                                                                  // 单位（kW/kWh等）
             std::chrono::system_clock::time_point timestamp;                                   // 数据时间戳
@@ -29,7 +36,7 @@ namespace dlt645 {
             // 带参数的构造函数
             DataItem(uint32_t di,
                      const std::string& name,
-                     const std::string& dataFormat,
+                     DataFormat dataFormat,
                      const std::variant<std::monostate, float, int32_t, uint32_t, std::string, Demand>& value,
                      const std::string& unit)
                 : di(di)
@@ -52,12 +59,106 @@ namespace dlt645 {
             }
         };
 
+        // 不区分结算日的数据项
+        inline constexpr uint8_t NO_SETTLEMENT_DAY = 0xFF;
+
+        // 最大结算日序号（上12结算日）
+        inline constexpr uint8_t MAX_SETTLEMENT_DAY = 12;
+
+        // 数据项元数据：目录中的静态信息，发布后不再修改，字符串驻留在DataItemManager中
+        struct DataItemMeta {
+            uint32_t di = 0;                             // 数据项地址
+            DataFormat dataFormat = DataFormat::Unknown; // 数据格式
+            uint8_t settlementDay = NO_SETTLEMENT_DAY;   // 结算日序号：0当前，1~12上N结算日
+            std::string_view name;                       // 数据名称（按结算日生成的数据项为类型名称，不含结算日前缀）
+            std::string_view unit;                       // 单位（kW/kWh等）
+
+            // 完整名称，如"（上1结算日）正向有功总电能"，按需拼接
+            std::string fullName() const;
+
+            bool operator==(const DataItemMeta&) const = default;
+        };
+
+        // 实时值：定长快照
+        struct LiveValue {
+            enum class Kind : uint8_t {
+                None = 0, // 未赋值
+                Float,    // 电能、变量
+                Demand,   // 需量及发生时间
+                Int32,    // 有符号整数
+                UInt32,   // 无符号整数
+            };
+
+            Kind kind = Kind::None;
+            float value = 0.0f;                              // Float、Demand的值
+            uint32_t bits = 0;                               // 值的位模式，Int32、UInt32按对应类型解释
+            std::chrono::system_clock::time_point occurTime; // 需量发生时间
+            std::chrono::system_clock::time_point timestamp; // 更新时间
+            uint64_t version = 0;                            // 每次更新加1
+        };
+
+        // 实时值槽位（32字节）：用序列锁保护，读者不加锁，读到写入中途的数据时重试
+        class ValueSlot {
+        public:
+            // 读取一致的快照
+            LiveValue load() const;
+
+            // 写入新值并递增版本号，多个写者之间互斥
+            void store(LiveValue::Kind kind,
+                       float value,
+                       std::chrono::system_clock::time_point occurTime,
+                       std::chrono::system_clock::time_point timestamp);
+
+            // 按位模式写入新值（整数类型），同store
+            void storeBits(LiveValue::Kind kind,
+                           uint32_t bits,
+                           std::chrono::system_clock::time_point occurTime,
+                           std::chrono::system_clock::time_point timestamp);
+
+            // 当前版本号
+            uint64_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+        private:
+            std::atomic<uint64_t> seq_ { 0 }; // 奇数表示正在写入
+            std::atomic<int64_t> occurTime_ { 0 };
+            std::atomic<int64_t> timestamp_ { 0 };
+            std::atomic<uint32_t> value_ { 0 }; // 值的位模式（float或整数）
+            std::atomic<uint8_t> kind_ { 0 };
+        };
+
+        // 数据项引用：指向目录中的元数据和值槽位。值槽位在DataItemManager生命周期内保持有效；
+        // 元数据在该DI的元数据下一次变化前有效，持有DataItemManager::ReadGuard期间不会被回收
+        struct DataItemRef {
+            const DataItemMeta* meta = nullptr;
+            ValueSlot* value = nullptr;
+            uint32_t slot = 0; // 槽位号：每个DI固定一个槽位，移除后重新加入仍沿用，可作为按DI索引的外部表的下标
+        };
+
         // 全局数据项映射表管理类
         class DataItemManager {
         public:
             // 构造函数
             DataItemManager();
 
+            ~DataItemManager();
+
+            DataItemManager(const DataItemManager&) = delete;
+            DataItemManager& operator=(const DataItemManager&) = delete;
+
+            // 读者区间：构造时在当前线程的分片上计数，析构时撤销；区间内加载的索引和元数据不会被回收。
+            // 区间内不能修改目录（结构变更要等待所有读者退出）
+            class ReadGuard {
+            public:
+                explicit ReadGuard(const DataItemManager& manager);
+                ~ReadGuard();
+
+                ReadGuard(const ReadGuard&) = delete;
+                ReadGuard& operator=(const ReadGuard&) = delete;
+
+            private:
+                std::atomic<uint32_t>& count_;
+            };
+
             // 初始化变量类型定义
             void initVariablesDef();
 
@@ -73,13 +174,25 @@ namespace dlt645 {
             // 从指定JSON文件加载类型定义
             int loadTypeDefsFromFile(const std::string& filePath, const DataType& dataType);
 
-            // 获取所有数据项类型定义
-            const std::unordered_map<uint32_t, DataItem>& getDataItems() const;
+            // 获取所有数据项（按当前值生成副本）
+            std::vector<std::shared_ptr<const DataItem>> getDataItems() const;
+
+            // 根据DI查找数据项（无锁），不拷贝任何数据
+            std::optional<DataItemRef> find(uint32_t di) const;
+
+            // 查找与di的DI3/DI2/DI1相同的全部数据项（所有结算日），按DI0升序
+            std::vector<DataItemRef> findSettlementDays(uint32_t di) const;
 
-            // 根据DI获取数据项类型定义 - 保持向后兼容
+            // 根据DI获取数据项副本（元数据+当前值） - 保持向后兼容
             std::shared_ptr<DataItem> getDataItem(uint32_t di) const;
 
-            // 根据DI更新数据项
+            // 根据DI写入浮点值（电能、变量），只更新值槽位
+            bool setValue(uint32_t di, float value);
+
+            // 根据DI写入需量值及发生时间，只更新值槽位
+            bool setDemand(uint32_t di, const Demand& demand);
+
+            // 根据DI更新数据项的值（元数据不可修改），字符串值不支持、返回false - 保持向后兼容
             bool updateDataItem(uint32_t di, const DataItem& dataItem);
 
             // 添加数据项类型定义
@@ -88,10 +201,93 @@ namespace dlt645 {
             // 移除数据项类型定义
             void removeDataItem(uint32_t di);
 
+            // 由元数据和值快照生成数据项
+            static DataItem toDataItem(const DataItemMeta& meta, const LiveValue& value);
+
         private:
-            // 数据项映射表
-            std::unordered_map<uint32_t, DataItem> diMap_;
-            // 互斥锁，用于线程安全
+            // 槽位按块分配，块一经分配不再移动或释放；元数据对象另行存放，块内只存指针，元数据变化时替换指针
+            static constexpr uint32_t CHUNK_SHIFT = 12;
+            static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_SHIFT;
+
+            // 费率数据项：每种类型64个费率/项，电能11种类型，需量10种类型
+            static constexpr uint32_t RATE_COUNT = 64;
+            static constexpr uint32_t ENERGY_GROUPS = 11;
+            static constexpr uint32_t DEMAND_GROUPS = 10;
+
+            struct Chunk {
+                std::array<std::atomic<const DataItemMeta*>, CHUNK_SIZE> meta {};
+                std::array<ValueSlot, CHUNK_SIZE> values;
+            };
+
+            // DI到槽位号的扁平索引及块表，发布后不再修改
+            struct Index {
+                DiIndex slots;
+                std::vector<Chunk*> chunks;
+
+                DataItemRef ref(uint32_t slot) const
+                {
+                    Chunk& chunk = *chunks[slot >> CHUNK_SHIFT];
+                    uint32_t offset = slot & (CHUNK_SIZE - 1);
+                    return { chunk.meta[offset].load(std::memory_order_acquire), &chunk.values[offset], slot };
+                }
+            };
+
+            // 读者计数分片：每个线程固定使用一个分片（按线程轮转分配），分片独占缓存行避免读者之间争用；
+            // 每个分片按纪元奇偶分两组计数，写者翻转纪元后新读者计入另一组，只需等待旧组归零
+            static constexpr size_t READER_SHARDS = 64;
+            struct alignas(64) ReaderShard {
+                std::array<std::atomic<uint32_t>, 2> count {};
+            };
+
+            // 宽限期：翻转纪元并等待之前进入的读者全部退出，之后旧索引和被替换的元数据不再被访问（调用方需持有mutex_，且不能处于读者区间内）
+            void synchronize();
+
+            // 由写者状态构建新索引并发布，等待宽限期后释放旧索引、回收被替换的元数据（调用方需持有mutex_）
+            void publish();
+
+            // 写入元数据：每个DI固定使用一个槽位，元数据变化时写入新对象后替换，旧对象在下一次发布的宽限期后复用；
+            // 返回值槽位，调用方随后需写入值（递增版本号，使按版本缓存的响应失效）并发布（调用方需持有mutex_）
+            ValueSlot& put(const DataItemMeta& meta);
+
+            // 写入数据项：驻留字符串后写入元数据和值（调用方需持有mutex_）
+            void put(const DataItem& dataItem);
+
+            // 按结算日规则生成baseDi的DI0=00H~0CH共13个数据项（调用方需持有mutex_）
+            void putSettlementDays(uint32_t baseDi, const DataItem& type, DataFormat dataFormat);
+
+            // 按规则生成电能、需量数据项（调用方需持有mutex_，生成后需调用publish）
+            void buildEnergyDefs();
+            void buildDemandDefs();
+
+            // 从JSON文件加载三种类型定义（调用方需持有mutex_，加载后需调用publish）
+            void loadTypeDefs();
+
+            // 字符串驻留（调用方需持有mutex_）
+            std::string_view intern(const std::string& str);
+
+            // 将DataItem中的值写入槽位；字符串值无法放入定长槽位，记录错误并返回false
+            static bool storeValue(ValueSlot& slot, const DataItem& dataItem);
+
+            // 从指定JSON文件加载类型定义（调用方需持有mutex_，加载后需调用publish）
+            int loadTypeDefs(const std::string& filePath, const DataType& dataType);
+
+            // 当前索引，读者在读者区间内加载，不加锁
+            std::atomic<const Index*> index_;
+            // 各分片上处于读者区间内的读者数及当前纪元
+            mutable std::array<ReaderShard, READER_SHARDS> readers_;
+            std::atomic<uint32_t> epoch_ { 0 };
+            // 写者状态：DI到槽位号的映射、已移除的DI保留的槽位、已分配的块及下一个空闲槽位号（仅在mutex_保护下访问）
+            std::unordered_map<uint32_t, uint32_t> slotMap_;
+            std::unordered_map<uint32_t, uint32_t> parked_;
+            std::vector<std::unique_ptr<Chunk>> chunks_;
+            uint32_t nextSlot_ = 0;
+            // 元数据对象（节点地址稳定）、可复用的对象及被替换后等待宽限期的对象（仅在mutex_保护下访问）
+            std::deque<DataItemMeta> metas_;
+            std::vector<DataItemMeta*> freeMetas_;
+            std::vector<DataItemMeta*> retiredMetas_;
+            // 驻留的名称和单位字符串（节点地址稳定）
+            std::unordered_set<std::string> strings_;
+            // 写者互斥锁，只用于串行化结构变更
             mutable std::mutex mutex_;
             std::vector<DataItem> energyTypes;
             std::vector<DataItem> demandTypes;
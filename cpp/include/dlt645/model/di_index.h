@@ -0,0 +1,85 @@
+#ifndef DLT645_DI_INDEX_H
+#define DLT645_DI_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dlt645 {
+    namespace model {
+
+        // DI到槽位号的扁平索引，构建后只读
+        // 查找：开放寻址哈希表（线性探测，桶为连续的8字节{DI, 槽位号}），一次乘法定位，通常只访问一条缓存行
+        // 范围：按DI升序存放的平行数组，DI3/DI2/DI1/DI0由高到低排列，同一前缀的DI连续存放
+        class DiIndex {
+        public:
+            inline constexpr static uint32_t NPOS = std::numeric_limits<uint32_t>::max();
+
+            // 范围查询结果：升序的DI及对应的槽位号
+            struct Range {
+                std::span<const uint32_t> dis;
+                std::span<const uint32_t> slots;
+
+                size_t size() const { return dis.size(); }
+                bool empty() const { return dis.empty(); }
+            };
+
+            DiIndex() = default;
+
+            // 由{DI, 槽位号}构建索引，DI不能重复
+            explicit DiIndex(std::vector<std::pair<uint32_t, uint32_t>> entries);
+
+            // 查找DI对应的槽位号，不存在时返回NPOS
+            uint32_t find(uint32_t di) const
+            {
+                if (buckets_.empty()) {
+                    return NPOS;
+                }
+                size_t pos = hash(di);
+                while (true) {
+                    const Bucket& bucket = buckets_[pos];
+                    if (bucket.slot == NPOS || bucket.di == di) {
+                        return bucket.slot;
+                    }
+                    pos = (pos + 1) & mask_;
+                }
+            }
+
+            // 是否包含DI
+            bool contains(uint32_t di) const { return find(di) != NPOS; }
+
+            // DI个数
+            size_t size() const { return dis_.size(); }
+
+            // DI在[first, last]范围内的全部数据项
+            Range range(uint32_t first, uint32_t last) const;
+
+            // 与di的DI3/DI2/DI1相同的全部数据项（即所有结算日，DI0 = 00H..FFH）
+            Range settlementDays(uint32_t di) const { return range(di & 0xFFFFFF00, di | 0x000000FF); }
+
+            // 全部数据项
+            Range all() const { return { dis_, slots_ }; }
+
+        private:
+            struct Bucket {
+                uint32_t di = 0;
+                uint32_t slot = NPOS;
+            };
+
+            // Fibonacci散列：乘法后取高位，DI各字节都参与
+            size_t hash(uint32_t di) const { return static_cast<size_t>((di * 0x9E3779B1u) >> shift_); }
+
+            std::vector<Bucket> buckets_;
+            size_t mask_ = 0;
+            uint32_t shift_ = 32;
+            std::vector<uint32_t> dis_;   // 升序DI
+            std::vector<uint32_t> slots_; // 与dis_平行的槽位号
+        };
+
+    } // namespace model
+} // namespace dlt645
+
+#endif // DLT645_DI_INDEX_H
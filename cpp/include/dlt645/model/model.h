@@ -7,7 +7,9 @@
 #include <cstdint>
 #include <span>
 #include <string>
+#include <string_view>
 #include <variant>
+#include "dlt645/common/transform.h"
 
 namespace dlt645 {
     namespace model {
@@ -28,18 +30,62 @@ namespace dlt645 {
         inline constexpr uint8_t CHANGE_BAUD_RATE = 0x17;    // 修改通信速率
         inline constexpr uint8_t CHANGE_PASSWORD = 0x18;     // 改变密码
 
-        // 数据格式常量
-        struct DataFormat {
-            inline constexpr static auto XXXXXXXXXXXX = "XXXXXXXXXXXX";
-            inline constexpr static auto XXXXXX_XX = "XXXXXX.XX";
-            inline constexpr static auto XXXX_XX = "XXXX.XX";
-            inline constexpr static auto XXX_XXX = "XXX.XXX";
-            inline constexpr static auto XXX_X = "XXX.X";
-            inline constexpr static auto XX_XXXX = "XX.XXXX";
-            inline constexpr static auto XX_XX = "XX.XX";
-            inline constexpr static auto X_XXX = "X.XXX";
+        // 异常应答：控制码D6置1，数据域为1字节错误信息字
+        inline constexpr uint8_t CTRL_ABNORMAL = 0x40; // 从站异常应答标志
+        inline constexpr uint8_t ERR_OTHER = 0x01;     // 错误信息字：其他错误
+
+        // 数据格式
+        enum class DataFormat : uint8_t {
+            Unknown = 0,
+            XXXXXXXXXXXX,
+            XXXXXXXX,
+            XXXXXX_XX,
+            XXXX_XX,
+            XXX_XXX,
+            XXX_X,
+            XX_XXXX,
+            XX_XX,
+            X_XXX,
+            Count,
+        };
+
+        // 数据格式描述：格式串及对应的BCD编解码参数（字节数、小数位数、取值范围）
+        struct DataFormatInfo {
+            DataFormat format;
+            std::string_view name;
+            common::BcdFormat bcd;
         };
 
+        // 数据格式描述表，按DataFormat取值索引
+        inline constexpr std::array<DataFormatInfo, static_cast<size_t>(DataFormat::Count)> DATA_FORMATS = { {
+            { DataFormat::Unknown, "", {} },
+            { DataFormat::XXXXXXXXXXXX, "XXXXXXXXXXXX", common::BcdFormat::parse("XXXXXXXXXXXX", false) },
+            { DataFormat::XXXXXXXX, "XXXXXXXX", common::BcdFormat::parse("XXXXXXXX", false) },
+            { DataFormat::XXXXXX_XX, "XXXXXX.XX", common::BcdFormat::parse("XXXXXX.XX") },
+            { DataFormat::XXXX_XX, "XXXX.XX", common::BcdFormat::parse("XXXX.XX") },
+            { DataFormat::XXX_XXX, "XXX.XXX", common::BcdFormat::parse("XXX.XXX") },
+            { DataFormat::XXX_X, "XXX.X", common::BcdFormat::parse("XXX.X") },
+            { DataFormat::XX_XXXX, "XX.XXXX", common::BcdFormat::parse("XX.XXXX") },
+            { DataFormat::XX_XX, "XX.XX", common::BcdFormat::parse("XX.XX") },
+            { DataFormat::X_XXX, "X.XXX", common::BcdFormat::parse("X.XXX") },
+        } };
+
+        // 获取数据格式描述
+        constexpr const DataFormatInfo& dataFormatInfo(DataFormat format)
+        {
+            size_t index = static_cast<size_t>(format);
+            return DATA_FORMATS[index < DATA_FORMATS.size() ? index : 0];
+        }
+
+        // 获取数据格式对应的BCD格式描述符
+        constexpr const common::BcdFormat& bcdFormat(DataFormat format) { return dataFormatInfo(format).bcd; }
+
+        // 数据格式转换为格式串
+        constexpr std::string_view toString(DataFormat format) { return dataFormatInfo(format).name; }
+
+        // 格式串转换为数据格式，无法识别时返回DataFormat::Unknown
+        DataFormat parseDataFormat(std::string_view name);
+
         // 需量结构体
         struct Demand {
             float value = 0.0f;                              // 需量值
@@ -51,7 +97,7 @@ namespace dlt645 {
             }
         };
 
-        bool isValueValid(const std::string& dataFormat, float value);
+        bool isValueValid(DataFormat dataFormat, float value);
 
     } // namespace model
 } // namespace dlt645
@@ -0,0 +1,50 @@
+#ifndef DLT645_PROTOCOL_CODEC_H
+#define DLT645_PROTOCOL_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace dlt645 {
+    namespace protocol {
+        namespace codec {
+
+            // 数据域±33H转换与模256校验和的融合内核
+            // 运行时根据CPU选择 AVX2 / SSE2 / NEON 实现，不支持时回退到标量实现
+
+            // 数据域编码：out[i] = in[i] + 33H，返回编码后字节的模256和（即该段对校验和的贡献）
+            // out至少需要in.size()字节，允许out与in指向同一缓冲区
+            uint8_t encode(std::span<const uint8_t> in, uint8_t* out);
+
+            // 数据域解码：out[i] = in[i] - 33H，返回解码前字节的模256和（用于校验接收帧）
+            // out至少需要in.size()字节，允许out与in指向同一缓冲区
+            uint8_t decode(std::span<const uint8_t> in, uint8_t* out);
+
+            // 模256求和
+            uint8_t sum(std::span<const uint8_t> in);
+
+            // 当前使用的内核名称（"avx2"、"sse2"、"neon"或"scalar"）
+            const char* kernelName();
+
+            // 各实现的函数表，供基准测试对比使用
+            struct Kernel {
+                const char* name;
+                uint8_t (*encode)(const uint8_t* in, uint8_t* out, size_t n);
+                uint8_t (*decode)(const uint8_t* in, uint8_t* out, size_t n);
+                uint8_t (*sum)(const uint8_t* in, size_t n);
+            };
+
+            // 标量实现
+            const Kernel& scalarKernel();
+
+            // 运行时选择的实现
+            const Kernel& activeKernel();
+
+            // 当前CPU上可用的全部实现（包括标量实现），返回个数
+            size_t availableKernels(std::span<const Kernel*> out);
+
+        } // namespace codec
+    } // namespace protocol
+} // namespace dlt645
+
+#endif // DLT645_PROTOCOL_CODEC_H
@@ -3,7 +3,9 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <array>
 #include <span>
@@ -14,6 +16,13 @@ namespace dlt645 {
         inline constexpr uint8_t FRAME_START_BYTE = 0x68;
         inline constexpr uint8_t FRAME_END_BYTE = 0x16;
         inline constexpr uint8_t BROADCAST_ADDR = 0xAA;
+        inline constexpr size_t MAX_DATA_LEN = 255;             // 数据域最大长度（长度字段为1字节）
+        inline constexpr size_t MAX_FRAME_LEN = 12 + MAX_DATA_LEN; // 不含前导字节的最大帧长度
+        inline constexpr size_t PREAMBLE_LEN = 4;                  // 发送帧的前导字节数
+        inline constexpr size_t MAX_ENCODED_LEN = PREAMBLE_LEN + MAX_FRAME_LEN;
+
+        class FrameView;
+        class FrameDecoder;
 
         // 帧结构体
         class Frame {
@@ -49,6 +58,14 @@ namespace dlt645 {
             static std::vector<uint8_t>
             buildFrame(std::span<const uint8_t, 6> addr, uint8_t ctrlCode, const std::vector<uint8_t>& data);
 
+            // 将帧（前导字节、帧头、+33H编码的数据域、校验和、结束符）一次正向写入out，
+            // 返回写入的字节数；out空间不足时返回0，不分配堆内存
+            static size_t encode(std::span<uint8_t> out,
+                                 std::span<const uint8_t, 6> addr,
+                                 uint8_t ctrlCode,
+                                 std::span<const uint8_t> data,
+                                 size_t preambleLen = PREAMBLE_LEN);
+
             // 解码数据域（±33H转换）
             static std::vector<uint8_t> decodeData(std::span<const uint8_t> data);
 
@@ -56,8 +73,99 @@ namespace dlt645 {
             static std::vector<uint8_t> encodeData(std::span<const uint8_t> data);
 
         private:
+            friend class FrameView;
+            friend class FrameDecoder;
+
             // 计算校验和（模256求和）
             static uint8_t calculateChecksum(std::span<const uint8_t> data);
+
+            // 从第一个68H写到16H，out至少需要12+data.size()字节，返回写入的字节数
+            static size_t encodeBody(uint8_t* out, std::span<const uint8_t, 6> addr, uint8_t ctrlCode, std::span<const uint8_t> data);
+        };
+
+        // 帧视图：不持有数据，直接引用调用方缓冲区中的一帧（从第一个68H到16H）
+        // 数据域保持±33H编码状态，按需解码，视图的生命周期不能超过底层缓冲区
+        class FrameView {
+        public:
+            // 从原始字节解析帧（允许带前导字节），在原缓冲区上完成校验和验证
+            static std::optional<FrameView> parse(std::span<const uint8_t> raw);
+
+            // 地址域
+            std::span<const uint8_t, 6> addr() const { return raw_.subspan<1, 6>(); }
+
+            // 控制码
+            uint8_t ctrlCode() const { return raw_[8]; }
+
+            // 数据域长度
+            uint8_t dataLen() const { return raw_[9]; }
+
+            // 校验和
+            uint8_t checkSum() const { return raw_[raw_.size() - 2]; }
+
+            // 未解码（+33H状态）的数据域
+            std::span<const uint8_t> encodedData() const { return raw_.subspan(10, dataLen()); }
+
+            // 解码单个数据字节
+            uint8_t dataAt(size_t index) const { return static_cast<uint8_t>(raw_[10 + index] - 0x33); }
+
+            // 将数据域解码到调用方提供的缓冲区，返回写入的字节数（缓冲区不足时返回0）
+            size_t decodeData(std::span<uint8_t> out) const;
+
+            // 整帧字节（不含前导字节）
+            std::span<const uint8_t> raw() const { return raw_; }
+
+            // 转换为持有数据的Frame
+            Frame toFrame() const;
+
+        private:
+            friend class FrameDecoder;
+
+            explicit FrameView(std::span<const uint8_t> raw)
+                : raw_(raw)
+            {
+            }
+
+            std::span<const uint8_t> raw_;
+        };
+
+        // 流式帧解码器：逐字节跟踪前导符、两个68H、长度、校验和及16H，
+        // 帧可以跨越任意读取分片边界，一个分片中的多个帧会被依次解出
+        class FrameDecoder {
+        public:
+            // 输入一段字节流，每解出一个完整帧调用一次 onFrame(const FrameView&)，返回解出的帧数
+            // 回调中的FrameView引用解码器内部缓冲区，仅在回调期间有效
+            template <typename Callback>
+            size_t feed(std::span<const uint8_t> chunk, Callback&& onFrame)
+            {
+                using Fn = std::remove_reference_t<Callback>;
+                return decode(
+                    chunk,
+                    [](void* ctx, const FrameView& frame) { (*static_cast<Fn*>(ctx))(frame); },
+                    const_cast<void*>(static_cast<const void*>(std::addressof(onFrame))));
+            }
+
+            // 丢弃未完成的帧
+            void reset();
+
+            // 是否处于帧间（没有未完成的帧）
+            bool idle() const { return state_ == State::Start; }
+
+            // 重同步时丢弃的字节数（不含前导FEH）
+            uint64_t discardedBytes() const { return discarded_; }
+
+        private:
+            enum class State : uint8_t { Start, Address, Start2, Control, Length, Data, CheckSum, End };
+
+            using FrameCallback = void (*)(void* ctx, const FrameView& frame);
+
+            size_t decode(std::span<const uint8_t> input, FrameCallback onFrame, void* ctx);
+
+            State state_ = State::Start;
+            std::array<uint8_t, MAX_FRAME_LEN> buf_ = { 0 }; // 当前帧（从第一个68H起）
+            size_t pos_ = 0;                                  // buf_中已缓存的字节数
+            size_t remaining_ = 0;                            // 数据域剩余字节数
+            uint8_t sum_ = 0;                                 // 滚动校验和
+            uint64_t discarded_ = 0;
         };
 
     } // namespace protocol
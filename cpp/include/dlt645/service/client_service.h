@@ -2,12 +2,14 @@
 #define DLT645_CLIENT_SERVICE_H
 #include "dlt645/model/data_item.h"
 #include "dlt645/protocol/protocol.h"
+#include "dlt645/service/device_health.h"
 #include "dlt645/transport/client/client_api.h"
 #include <array>
 #include <chrono>
 #include <cstdint>
 #include <future>
 #include <memory>
+#include <span>
 #include <thread>
 #include <vector>
 
@@ -20,20 +22,22 @@ namespace dlt645 {
             ClientService(std::shared_ptr<transport::client::Connection> conn);
             ~ClientService();
 
-            // 创建TCP客户端服务
+            // 创建TCP客户端服务（pool非空时多个客户端共享同一个io_context池，见TcpClient）
             static std::shared_ptr<ClientService> createTcpClient(const std::string& ip,
                                                                   uint16_t port,
                                                                   std::chrono::milliseconds timeout
-                                                                  = std::chrono::milliseconds(5000));
+                                                                  = std::chrono::milliseconds(5000),
+                                                                  std::shared_ptr<transport::IoContextPool> pool = nullptr);
 
-            // 创建RTU客户端服务
+            // 创建RTU客户端服务（pool非空时多个客户端共享同一个io_context池，见RtuClient）
             static std::shared_ptr<ClientService> createRtuClient(const std::string& port,
                                                                   int baudrate,
                                                                   int databits = 8,
                                                                   int stopbits = 1,
                                                                   const std::string& parity = "none",
                                                                   std::chrono::milliseconds timeout
-                                                                  = std::chrono::milliseconds(5000));
+                                                                  = std::chrono::milliseconds(5000),
+                                                                  std::shared_ptr<transport::IoContextPool> pool = nullptr);
 
             // 设置设备地址
             bool setAddress(const std::array<uint8_t, 6>& address);
@@ -50,6 +54,12 @@ namespace dlt645 {
             // 读取变量（02类）
             std::shared_ptr<model::DataItem> read02(uint32_t di);
 
+            // 批量读取数据项（00/01/02类），结果与dis一一对应，失败的项为nullptr
+            // 请求一次全部发出：TCP连接设置了流水线窗口（TcpClientConfig::maxInFlight）时，吞吐量随窗口增大而不受往返时延限制
+            // timeout为0时使用按往返时延估计的超时（见DeviceHealth）；表计熔断后，还在窗口外排队的项不再发出，直接失败
+            std::vector<std::shared_ptr<model::DataItem>> readMany(std::span<const uint32_t> dis,
+                                                                   std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
             // 读取通讯地址
             std::shared_ptr<model::DataItem> readAddress();
 
@@ -62,6 +72,25 @@ namespace dlt645 {
             // 广播校时
             bool broadcastTimeSync();
 
+            // 协程接口：co_await等待响应期间不占用线程，也不经过promise/future，完成后在调用方协程的执行器上恢复
+            // 连接需事先建立（connect），超时按往返时延估计；这些接口不加mutex_，同一ClientService的协程应在同一个执行器上运行
+            boost::asio::awaitable<std::shared_ptr<model::DataItem>> asyncReadDataItem(uint32_t di);
+
+            // 读取通讯地址（协程）
+            boost::asio::awaitable<std::shared_ptr<model::DataItem>> asyncReadAddress();
+
+            // 写入通讯地址（协程）
+            boost::asio::awaitable<std::shared_ptr<model::DataItem>> asyncWriteAddress(const std::array<uint8_t, 6>& newAddress);
+
+            // 广播校时（协程）
+            boost::asio::awaitable<bool> asyncBroadcastTimeSync();
+
+            // 设置往返时延估计与熔断参数（应答超时范围、熔断阈值和时长）
+            void setHealthConfig(const DeviceHealthConfig& config) { health_->configure(config); }
+
+            // 设备健康统计：往返时延估计、当前应答超时和熔断状态
+            DeviceHealthStats health() const { return health_->stats(); }
+
             // 连接设备
             bool connect() { return connection_->connect(); }
 
@@ -74,16 +103,28 @@ namespace dlt645 {
             std::shared_ptr<transport::client::Connection> connection_;
             std::unique_ptr<std::thread> executor_;
             std::mutex mutex_;
+            std::shared_ptr<DeviceHealth> health_; // 响应回调可能晚于本对象析构，共享持有
 
             // 验证设备
-            bool validateDevice(const std::array<uint8_t, 6>& addr) const;
+            bool validateDevice(std::span<const uint8_t, 6> addr) const;
 
-            // 发送请求并处理响应（带超时控制）
+            // 发送请求并处理响应（带超时控制，timeout为0时使用按往返时延估计的超时）
             std::shared_ptr<model::DataItem> sendAndHandleRequest(const std::vector<uint8_t>& frame,
-                                                                  std::chrono::milliseconds timeout = std::chrono::seconds(5));
+                                                                  std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+            // 发送请求并记录往返时延或失败；熔断中不发送，排队期间熔断的请求在发出前跳过，均直接以空响应结束
+            void sendTracked(const std::vector<uint8_t>& frame,
+                             std::chrono::milliseconds timeout,
+                             transport::client::Connection::ResponseHandler handler);
+
+            // 把连接的回调接口适配为可co_await的操作，响应为空表示失败；tracked为false时不计入设备健康（广播无应答）
+            boost::asio::awaitable<std::vector<uint8_t>> asyncSend(std::vector<uint8_t> frame, bool tracked = true);
+
+            // 解析并验证响应帧，再交给handleResponse处理
+            std::shared_ptr<model::DataItem> processResponse(const std::vector<uint8_t>& response);
 
             // 处理响应
-            std::shared_ptr<model::DataItem> handleResponse(const std::shared_ptr<protocol::Frame>& frame);
+            std::shared_ptr<model::DataItem> handleResponse(const protocol::FrameView& frame);
 
             // 从字节数据获取时间
             std::chrono::system_clock::time_point getTime(const std::vector<uint8_t>& t) const;
@@ -0,0 +1,105 @@
+#ifndef DLT645_DEVICE_HEALTH_H
+#define DLT645_DEVICE_HEALTH_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace dlt645 {
+    namespace service {
+
+        // 设备健康配置
+        struct DeviceHealthConfig {
+            std::chrono::milliseconds initialTimeout { 2000 };    // 还没有往返时延样本时的应答超时
+            std::chrono::milliseconds minTimeout { 200 };         // 应答超时下限
+            std::chrono::milliseconds maxTimeout { 5000 };        // 应答超时上限（退避后也不超过）
+            uint32_t failureThreshold = 3;                        // 连续失败该次数后熔断
+            std::chrono::milliseconds openDuration { 1000 };      // 首次熔断时长，之后每次探测失败翻倍
+            std::chrono::milliseconds maxOpenDuration { 300000 }; // 熔断时长上限
+        };
+
+        // 熔断状态
+        enum class CircuitState {
+            Closed,   // 正常发送
+            Open,     // 熔断中，请求直接失败，不占用链路
+            HalfOpen, // 熔断时长已到，只放行一个探测请求
+        };
+
+        // 设备健康统计
+        struct DeviceHealthStats {
+            CircuitState state = CircuitState::Closed;
+            std::chrono::microseconds srtt { 0 };   // 平滑往返时延
+            std::chrono::microseconds rttvar { 0 }; // 往返时延平均偏差
+            std::chrono::milliseconds timeout { 0 }; // 下一次请求使用的应答超时
+            uint32_t consecutiveFailures = 0;
+            uint64_t successes = 0;
+            uint64_t failures = 0;
+            uint64_t rejected = 0; // 熔断期间直接失败的请求数
+            uint32_t opens = 0;    // 连续熔断次数，决定下一次熔断时长
+            std::chrono::steady_clock::time_point openUntil; // 熔断到期时刻（state为Open时有效）
+        };
+
+        // 单个设备的往返时延估计与熔断（可在多个线程中使用）
+        // 应答超时按TCP重传超时的算法（RFC 6298）从往返时延得出：srtt、rttvar分别以1/8、1/4的权重平滑，
+        // 超时 = srtt + 4 × rttvar，限制在[minTimeout, maxTimeout]内；每次失败超时翻倍，成功后恢复。
+        // 连续失败failureThreshold次后熔断，熔断时长到后放行一个探测请求，探测成功恢复正常，失败则熔断时长翻倍。
+        // 每次状态切换使代次加一，请求放行时记下当时的代次（Ticket）；流水线上熔断前已发出的请求晚到的结果
+        // 代次已过期，只计入统计，不再改变状态，也不会让熔断时长继续翻倍
+        class DeviceHealth {
+        public:
+            // 放行凭据：放行时的状态代次
+            struct Ticket {
+                uint64_t generation = 0;
+            };
+
+            explicit DeviceHealth(const DeviceHealthConfig& config = {});
+
+            // 修改配置，不清除已有的时延估计
+            void configure(const DeviceHealthConfig& config);
+
+            // 请求前调用，返回空表示熔断中，本次请求应直接失败
+            std::optional<Ticket> acquire(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+            // 请求排队后实际发出前再次检查：凭据仍有效时放行；排队期间状态已改变时按acquire重新判断并更新凭据，
+            // 返回false表示排队期间已熔断，本次请求不应再占用链路
+            bool admit(Ticket& ticket, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+            // 本次请求的应答超时
+            std::chrono::milliseconds timeout() const;
+
+            // 收到响应，rtt为从发出到收到响应的时间
+            void onSuccess(const Ticket& ticket, std::chrono::steady_clock::duration rtt);
+
+            // 请求失败（超时或连接断开）
+            void onFailure(const Ticket& ticket, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+            DeviceHealthStats stats() const;
+
+        private:
+            static constexpr uint32_t MAX_BACKOFF_SHIFT = 16;
+
+            std::chrono::milliseconds timeoutLocked() const;
+            std::optional<Ticket> acquireLocked(std::chrono::steady_clock::time_point now);
+            void open(std::chrono::steady_clock::time_point now);
+
+            mutable std::mutex mutex_;
+            DeviceHealthConfig config_;
+            bool hasSample_ = false;
+            std::chrono::microseconds srtt_ { 0 };
+            std::chrono::microseconds rttvar_ { 0 };
+            uint32_t backoffShift_ = 0; // 超时翻倍次数
+            CircuitState state_ = CircuitState::Closed;
+            uint64_t generation_ = 0; // 状态代次，每次状态切换加一
+            uint32_t consecutiveFailures_ = 0;
+            uint32_t opens_ = 0; // 连续熔断次数，决定熔断时长
+            std::chrono::steady_clock::time_point openUntil_;
+            uint64_t successes_ = 0;
+            uint64_t failures_ = 0;
+            uint64_t rejected_ = 0;
+        };
+
+    } // namespace service
+} // namespace dlt645
+
+#endif // DLT645_DEVICE_HEALTH_H
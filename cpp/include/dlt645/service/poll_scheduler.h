@@ -0,0 +1,148 @@
+#ifndef DLT645_POLL_SCHEDULER_H
+#define DLT645_POLL_SCHEDULER_H
+
+#include "dlt645/model/data_item.h"
+#include "dlt645/service/client_service.h"
+#include "dlt645/transport/client/client_api.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+
+namespace dlt645 {
+    namespace service {
+
+        // 一个表计的轮询计划：每隔interval按顺序读取一遍dis
+        struct PollTarget {
+            std::array<uint8_t, 6> address = { 0 };
+            std::vector<uint32_t> dis;
+            std::chrono::milliseconds interval = std::chrono::seconds(60);
+        };
+
+        // 一次读取的结果，item为nullptr表示失败（超时、未连接或响应无效）
+        struct PollResult {
+            std::array<uint8_t, 6> address = { 0 };
+            uint32_t di = 0;
+            std::shared_ptr<model::DataItem> item;
+            std::chrono::steady_clock::time_point time;
+        };
+
+        // 轮询统计（自start起累计）
+        struct PollStats {
+            double targetRate = 0;   // 按计划应达到的读取速率（次/秒）
+            double achievedRate = 0; // 实际完成的读取速率（次/秒，含失败）
+            uint64_t completed = 0;  // 成功的读取次数
+            uint64_t failed = 0;     // 失败的读取次数
+            uint64_t skipped = 0;    // 因链路跟不上而跳过的轮询周期数（每个表计每跳过一个周期计1）
+        };
+
+        // 轮询调度器配置
+        struct PollSchedulerConfig {
+            std::chrono::milliseconds tick { 10 };           // 时间轮刻度
+            size_t wheelSize = 1024;                         // 时间轮槽数
+            std::chrono::milliseconds timeout { 2000 };      // 应答超时上限，每个表计按往返时延自适应（见DeviceHealth）
+            size_t batchSize = 256;                          // 结果攒够该数量即交付
+            std::chrono::milliseconds batchInterval { 100 }; // 结果最长攒该时间即交付
+            uint32_t seed = 645;                             // 首次轮询时间抖动的随机种子
+        };
+
+        // 大批量表计轮询调度器
+        // 每个链路（Connection）是一条独立的总线或网关连接，链路上的表计按到期先后排队，
+        // 同一链路同时等待响应的读取数不超过该链路的maxInFlight（RS-485总线为1），各链路互不阻塞；
+        // 表计首次轮询时间在[0, interval)内随机抖动，避免所有表计同时到期；到期时刻用哈希时间轮管理，
+        // 表计读完一轮后按计划时刻（而非完成时刻）排下一轮，落后超过一个周期时跳过错过的周期并计入skipped
+        //
+        // 读取通过每个表计各自的ClientService协程接口完成，熔断中的表计直接记为失败、不占用链路；调度器的状态只在自己的IO线程访问，
+        // 结果按批在该线程中交给回调；链路和表计需在start前添加
+        class PollScheduler {
+        public:
+            using BatchHandler = std::function<void(std::vector<PollResult>&)>;
+
+            PollScheduler(const PollSchedulerConfig& config, BatchHandler handler);
+            ~PollScheduler();
+
+            PollScheduler(const PollScheduler&) = delete;
+            PollScheduler& operator=(const PollScheduler&) = delete;
+
+            // 添加链路，返回链路编号；maxInFlight为链路上同时等待响应的读取数，TCP连接需与TcpClientConfig::maxInFlight配合
+            size_t addLink(std::shared_ptr<transport::client::Connection> connection, size_t maxInFlight = 1);
+
+            // 在链路上添加表计，链路编号无效、DI列表为空、周期为0或已启动时返回false
+            bool addMeter(size_t link, const PollTarget& target);
+
+            // 连接尚未连接的链路并开始轮询（连接失败的链路上的读取记为失败）
+            bool start();
+
+            // 停止轮询，交付尚未交付的结果
+            void stop();
+
+            // 轮询统计（可在任意线程调用）
+            PollStats stats() const;
+
+        private:
+            // 表计使用的链路句柄：不拥有链路连接，ClientService析构时的断开不影响同一链路上的其他表计
+            class LinkChannel;
+
+            struct Meter {
+                PollTarget target;
+                std::shared_ptr<ClientService> client;
+                size_t link = 0;
+                uint64_t intervalTicks = 1;
+                uint64_t dueTick = 0; // 本轮计划时刻（时间轮刻度）
+            };
+
+            struct Link {
+                std::shared_ptr<transport::client::Connection> connection;
+                size_t maxInFlight = 1;
+                size_t inFlight = 0;
+                std::deque<size_t> ready; // 已到期、等待读取的表计
+                double rate = 0;          // 计划读取速率（次/秒）
+            };
+
+            PollSchedulerConfig config_;
+            BatchHandler handler_;
+            std::vector<Meter> meters_;
+            std::vector<Link> links_;
+            std::vector<std::vector<size_t>> wheel_; // 时间轮：每个槽为到期刻度落在该槽的表计
+            uint64_t currentTick_ = 0;               // 已处理到的刻度
+            std::vector<PollResult> batch_;
+            std::chrono::steady_clock::time_point lastFlush_;
+
+            boost::asio::io_context io_context_;
+            boost::asio::steady_timer timer_;
+            std::thread thread_;
+            bool running_ = false;  // 只在调用start/stop的线程访问
+            bool stopping_ = false; // 只在IO线程访问
+            std::chrono::steady_clock::time_point start_;
+
+            std::atomic<uint64_t> completed_ { 0 };
+            std::atomic<uint64_t> failed_ { 0 };
+            std::atomic<uint64_t> skipped_ { 0 };
+
+            // 把表计放入到期刻度对应的槽
+            void schedule(size_t meter);
+
+            // 时间轮前进到当前时刻，把到期的表计移入所属链路的就绪队列
+            void onTick();
+
+            // 链路未满时开始读取就绪的表计
+            void pump(size_t link);
+
+            // 按顺序读取一个表计的全部DI，完成后排下一轮
+            boost::asio::awaitable<void> poll(size_t index);
+
+            // 交付已攒的结果
+            void flush();
+        };
+
+    } // namespace service
+} // namespace dlt645
+
+#endif // DLT645_POLL_SCHEDULER_H
@@ -0,0 +1,50 @@
+#ifndef DLT645_RESPONSE_CACHE_H
+#define DLT645_RESPONSE_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace dlt645 {
+    namespace service {
+
+        // 已编码响应帧缓存：按（请求地址，值槽位，值版本号）缓存读数据的完整响应帧
+        // 值写入时槽位版本号递增，旧版本的缓存自然失效；重复读取只需一次复制
+        // 直接映射、固定容量，每个条目用序列锁保护，读者和写者都不加锁，写冲突时放弃写入
+        class ResponseCache {
+        public:
+            // 可缓存的最大帧长度（读数据响应不超过该长度）
+            static constexpr size_t MAX_FRAME_LEN = 48;
+
+            // capacity为条目数，向上取2的幂
+            explicit ResponseCache(size_t capacity = 2048);
+
+            // 命中时把响应帧复制到out并返回长度，未命中返回0
+            size_t lookup(uint64_t address, const void* slot, uint64_t version, std::span<uint8_t> out) const;
+
+            // 写入响应帧，帧过长或条目正被其他线程写入时忽略
+            void store(uint64_t address, const void* slot, uint64_t version, std::span<const uint8_t> frame);
+
+        private:
+            struct Entry {
+                std::atomic<uint64_t> seq { 0 }; // 奇数表示正在写入
+                std::atomic<uintptr_t> slot { 0 };
+                std::atomic<uint64_t> address { 0 };
+                std::atomic<uint64_t> version { 0 };
+                std::atomic<uint32_t> length { 0 };
+                std::array<std::atomic<uint64_t>, MAX_FRAME_LEN / 8> words {};
+            };
+
+            size_t indexOf(uint64_t address, uintptr_t slot) const;
+
+            std::unique_ptr<Entry[]> entries_;
+            size_t mask_ = 0;
+        };
+
+    } // namespace service
+} // namespace dlt645
+
+#endif // DLT645_RESPONSE_CACHE_H
@@ -0,0 +1,122 @@
+#ifndef DLT645_RTU_BUS_H
+#define DLT645_RTU_BUS_H
+
+#include "dlt645/service/client_service.h"
+#include "dlt645/transport/client/client_api.h"
+#include "dlt645/transport/rtu_timing.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dlt645 {
+    namespace service {
+
+        // 总线统计（自创建或resetStats起累计）
+        struct RtuBusStats {
+            uint64_t transactions = 0;               // 完成的交换次数（含失败）
+            uint64_t failed = 0;                     // 失败的交换次数（超时、响应截断或端口断开）
+            uint64_t skipped = 0;                    // 轮到时调用方已不再需要发出（如表计已熔断），未占用线路的交换数
+            size_t queued = 0;                       // 当前排队等待的交换数
+            std::chrono::microseconds busy { 0 };    // 总线上有交换进行的累计时间
+            std::chrono::microseconds wire { 0 };    // 请求和响应字节按字符时间折算的线路传输时间
+            std::chrono::microseconds elapsed { 0 }; // 统计时长
+            double utilization = 0;                  // 总线占用率 busy / elapsed（含收发切换和表计应答等待）
+            double wireUtilization = 0;              // 线路传输占比 wire / elapsed
+        };
+
+        // 多点RS-485总线仲裁：一个串口连接上挂多个表计
+        // 总线独占串口连接，为每个表计地址提供一个ClientService句柄；所有句柄的请求在总线上排队，
+        // 同一时刻线路上只有一个请求-响应交换。排队的交换按地址轮转（每个地址内按提交顺序），
+        // 一个表计排了大量请求时不会饿死其他表计；上一个交换在IO线程中结束时立即发出下一个，
+        // 线路空闲只剩收发切换间隔（见RtuTiming），调用方线程的唤醒不占用总线时间
+        //
+        // 句柄的同步接口、readMany和协程接口都可并发使用，不需要setAddress；
+        // 句柄的disconnect不关闭串口，串口随总线connect/disconnect
+        class RtuBus : public std::enable_shared_from_this<RtuBus> {
+        public:
+            // timing为串口线路参数，只用于折算线路传输时间
+            explicit RtuBus(std::shared_ptr<transport::client::Connection> port, const transport::RtuTiming& timing = {});
+            ~RtuBus();
+
+            RtuBus(const RtuBus&) = delete;
+            RtuBus& operator=(const RtuBus&) = delete;
+
+            // 创建RTU总线（参数同ClientService::createRtuClient）
+            static std::shared_ptr<RtuBus> createRtuBus(const std::string& port,
+                                                        int baudrate,
+                                                        int databits = 8,
+                                                        int stopbits = 1,
+                                                        const std::string& parity = "none",
+                                                        std::chrono::milliseconds timeout = std::chrono::milliseconds(5000),
+                                                        std::shared_ptr<transport::IoContextPool> pool = nullptr);
+
+            // 表计地址对应的客户端句柄（每次调用返回新的ClientService，地址相同的句柄共享排队顺序）
+            std::shared_ptr<ClientService> client(const std::array<uint8_t, 6>& address);
+
+            // 打开串口
+            bool connect(std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+            // 关闭串口，排队的交换全部以失败结束
+            void disconnect();
+
+            bool isConnected() const { return port_->isConnected(); }
+
+            // 总线统计（可在任意线程调用）
+            RtuBusStats stats() const;
+
+            // 清零统计并重新开始计时
+            void resetStats();
+
+        private:
+            // 句柄使用的连接：把请求交给总线排队
+            class Channel;
+
+            struct Transaction {
+                std::vector<uint8_t> frame;
+                std::chrono::milliseconds timeout;
+                transport::client::Connection::AdmitHandler admit; // 轮到本交换、即将占用线路时回调（可为空）
+                transport::client::Connection::SentHandler onSent; // 在线路上发出时回调（可为空），不含在总线上排队的时间
+                transport::client::Connection::ResponseHandler handler;
+            };
+
+            std::shared_ptr<transport::client::Connection> port_;
+            transport::RtuTiming timing_;
+
+            mutable std::mutex mutex_;
+            std::unordered_map<uint64_t, std::deque<Transaction>> pending_; // 按地址排队的交换
+            std::deque<uint64_t> rotation_;                                 // 有交换排队的地址，按轮转顺序
+            size_t queued_ = 0;
+            bool busy_ = false; // 线路上有交换进行
+            std::chrono::steady_clock::time_point busySince_;
+
+            uint64_t transactions_ = 0;
+            uint64_t failed_ = 0;
+            uint64_t skipped_ = 0;
+            uint64_t wireChars_ = 0;
+            std::chrono::steady_clock::duration busyTime_ { 0 };
+            std::chrono::steady_clock::time_point statsSince_;
+
+            // 提交一个交换（任意线程）
+            void submit(uint64_t address, Transaction transaction);
+
+            // 线路空闲时发出轮转顺序上的下一个交换
+            void dispatch();
+
+            // 交换结束：记录统计并发出下一个交换，再把响应交给提交方
+            void complete(size_t requestChars, transport::client::Connection::ResponseHandler handler, std::vector<uint8_t> response);
+
+            // 以失败结束所有排队的交换
+            void failPending();
+        };
+
+    } // namespace service
+} // namespace dlt645
+
+#endif // DLT645_RTU_BUS_H
@@ -4,12 +4,16 @@
 #include "dlt645/model/data_item.h"
 #include "dlt645/model/model.h"
 #include "dlt645/protocol/protocol.h"
+#include "dlt645/service/response_cache.h"
+#include "dlt645/service/virtual_meter.h"
 #include "dlt645/transport/server/server_api.h"
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
 #include <optional>
+#include <span>
 #include <string>
 
 namespace dlt645 {
@@ -28,7 +32,7 @@ namespace dlt645 {
             void registerDevice(const std::array<uint8_t, 6>& addr);
 
             // 验证设备地址
-            bool validateDevice(const std::array<uint8_t, 6>& address) const;
+            bool validateDevice(std::span<const uint8_t, 6> address) const;
 
             // 设置时间
             void setTime(const std::vector<uint8_t>& dataBytes);
@@ -45,23 +49,38 @@ namespace dlt645 {
             // 写变量
             bool set02(uint32_t di, float value);
 
+            // 启用虚拟多表计：一个服务实例应答多个地址，需在start之前调用
+            // maxMeters为最多登记的表计数，valuesPerMeter为每个表计最多单独保存的值个数
+            void enableVirtualMeters(size_t maxMeters, size_t valuesPerMeter = 64);
+
+            // 登记虚拟表计地址，未启用或超过容量时返回false
+            bool addMeter(const std::array<uint8_t, 6>& address);
+
+            // 已登记的虚拟表计数
+            size_t meterCount() const;
+
+            // 写指定虚拟表计的值，未写过的DI读取时使用set00/set01/set02写入的共享值
+            bool set00(const std::array<uint8_t, 6>& address, uint32_t di, float value);
+            bool set01(const std::array<uint8_t, 6>& address, uint32_t di, const model::Demand& value);
+            bool set02(const std::array<uint8_t, 6>& address, uint32_t di, float value);
+
             // 设置密码
             void setPassword(const std::array<uint8_t, 4>& password);
 
             // 获取数据项
             std::shared_ptr<model::DataItem> getDataItem(uint32_t di) const;
 
-            // 处理请求
-            std::vector<uint8_t> handleRequest(const protocol::Frame& frame);
+            // 处理请求，响应帧写入out，返回写入长度（0表示无响应）
+            size_t handleRequest(const protocol::FrameView& frame, std::span<uint8_t> out);
 
-            // 处理电能读取请求
-            std::vector<uint8_t> handleReadEnergy(const protocol::Frame& frame);
+            // 处理电能读取请求（data为已解码的数据域）
+            size_t handleReadEnergy(const protocol::FrameView& frame, std::span<const uint8_t> data, std::span<uint8_t> out);
 
             // 处理最大需量读取请求
-            std::vector<uint8_t> handleReadDemand(const protocol::Frame& frame);
+            size_t handleReadDemand(const protocol::FrameView& frame, std::span<const uint8_t> data, std::span<uint8_t> out);
 
             // 处理变量读取请求
-            std::vector<uint8_t> handleReadVariable(const protocol::Frame& frame);
+            size_t handleReadVariable(const protocol::FrameView& frame, std::span<const uint8_t> data, std::span<uint8_t> out);
 
             // 连接关闭回调
             void onConnectionClosed();
@@ -73,18 +92,30 @@ namespace dlt645 {
             void stop();
 
             // 获取当前地址
-            const std::array<uint8_t, 6>& getAddress() const { return address_; }
+            std::array<uint8_t, 6> getAddress() const;
 
             // 获取当前密码
-            const std::array<uint8_t, 4>& getPassword() const { return password_; }
+            std::array<uint8_t, 4> getPassword() const;
 
             // 初始化方法，用于设置连接处理器
             void init();
 
         private:
+            // 请求地址对应的值槽位：虚拟表计写过该DI时返回表计自己的值，否则返回共享值
+            const model::ValueSlot& valueFor(std::span<const uint8_t, 6> address, const model::DataItemRef& ref) const;
+
+            // 异常应答帧写入out，返回写入长度
+            size_t encodeError(const protocol::FrameView& frame, uint8_t error, std::span<uint8_t> out) const;
+
+            // 查找并校验虚拟表计的值槽位，失败时返回nullptr
+            model::ValueSlot* meterValue(const std::array<uint8_t, 6>& address, uint32_t di, float value);
+
             std::shared_ptr<transport::server::Server> server_; // 服务器实例
-            std::array<uint8_t, 6> address_;                    // 设备地址
-            std::array<uint8_t, 4> password_;                   // 设备密码
+            // 地址和密码按整数原子存放：多个IO线程并发处理请求时，写地址命令与校验地址互不加锁
+            std::atomic<uint64_t> address_ { 0 };               // 设备地址（低6字节）
+            std::atomic<uint32_t> password_ { 0 };              // 设备密码
+            ResponseCache responseCache_;                       // 读数据响应帧缓存，值版本号变化后失效
+            std::unique_ptr<MeterRegistry> meters_;             // 虚拟表计登记表（未启用时为空）
         };
 
         // 创建TCP服务端服务
@@ -0,0 +1,142 @@
+#ifndef DLT645_TCP_CLIENT_POOL_H
+#define DLT645_TCP_CLIENT_POOL_H
+
+#include "dlt645/service/client_service.h"
+#include "dlt645/transport/client/client_api.h"
+#include "dlt645/transport/io_context_pool.h"
+#include <array>
+#include <atomic>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dlt645 {
+    namespace service {
+
+        // 连接池配置
+        struct TcpClientPoolConfig {
+            transport::client::TcpClientConfig client;             // 每个连接的配置（地址、端口、连接和应答超时、流水线窗口）
+            size_t size = 4;                                       // 连接数
+            std::chrono::milliseconds reconnectDelay { 500 };      // 重连失败后的首次等待，之后每次失败翻倍
+            std::chrono::milliseconds maxReconnectDelay { 30000 }; // 重连等待上限
+            std::chrono::milliseconds idleTimeout { 30000 };       // 连接上该时间内没有收到响应时发送探测帧，0表示不探测
+            std::chrono::milliseconds probeTimeout { 2000 };       // 探测帧的应答超时，超时则关闭连接并重连
+            // 探测帧（读通讯地址）的目标地址（默认为通配地址，网关后只有一个表计或网关自身应答时适用）
+            std::array<uint8_t, 6> probeAddress = { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA };
+            std::chrono::milliseconds checkInterval { 100 };       // 后台检查连接状态的间隔
+        };
+
+        // 连接池统计
+        struct TcpClientPoolStats {
+            size_t size = 0;              // 连接数
+            size_t warm = 0;              // 当前可用的连接数
+            uint64_t requests = 0;        // 分配到连接上的请求数
+            uint64_t rejected = 0;        // 没有可用连接、直接失败的请求数
+            uint64_t reconnects = 0;      // 断开后重新建立的连接次数
+            uint64_t connectFailures = 0; // 建立连接失败的次数
+            uint64_t probeFailures = 0;   // 探测无应答而关闭的连接数
+        };
+
+        // TCP网关连接池：对同一个网关预先建立多个TcpClient连接
+        // 每个请求交给一个可用连接（等待响应的请求最少者优先）；连接上一段时间没有收到响应时发送探测帧，
+        // 连接断开或探测无应答时由后台线程关闭并按退避重连，
+        // 请求只会分配给已建立的连接，没有可用连接时直接失败，重连耗时不计入任何一次读取；
+        // 句柄的connect不发起连接，只反映池中是否有可用连接，disconnect不关闭池中的连接
+        class TcpClientPool : public std::enable_shared_from_this<TcpClientPool> {
+        public:
+            // pool非空时所有连接在共享的io_context池上运行
+            explicit TcpClientPool(const TcpClientPoolConfig& config, std::shared_ptr<transport::IoContextPool> pool = nullptr);
+            ~TcpClientPool();
+
+            TcpClientPool(const TcpClientPool&) = delete;
+            TcpClientPool& operator=(const TcpClientPool&) = delete;
+
+            // 创建连接池（ip、port、timeout同ClientService::createTcpClient，size为连接数）
+            static std::shared_ptr<TcpClientPool> createTcpClientPool(const std::string& ip,
+                                                                      uint16_t port,
+                                                                      size_t size = 4,
+                                                                      std::chrono::milliseconds timeout = std::chrono::milliseconds(5000),
+                                                                      std::shared_ptr<transport::IoContextPool> pool = nullptr);
+
+            // 同时建立所有连接（最长一个连接超时）并启动后台检查，至少一个连接建立成功时返回true；
+            // 建立失败的连接在后台继续重连
+            bool start();
+
+            // 停止后台检查并关闭所有连接
+            void stop();
+
+            // 使用连接池的连接（可交给PollScheduler::addLink等）
+            std::shared_ptr<transport::client::Connection> connection();
+
+            // 表计地址对应的客户端句柄（每次调用返回新的ClientService）
+            std::shared_ptr<ClientService> client(const std::array<uint8_t, 6>& address);
+
+            // 是否有可用连接
+            bool isConnected() const { return warm_.load(std::memory_order_relaxed) > 0; }
+
+            // 连接池统计（可在任意线程调用）
+            TcpClientPoolStats stats() const;
+
+        private:
+            // 句柄使用的连接：每个请求分配一个可用连接
+            class Channel;
+
+            // 一个池中连接
+            struct Member;
+
+            TcpClientPoolConfig config_;
+            std::shared_ptr<transport::IoContextPool> pool_;
+            std::vector<std::unique_ptr<Member>> members_;
+            std::vector<uint8_t> probeFrame_;
+            std::atomic<size_t> next_ { 0 }; // 选择连接的起始位置，轮转以分散负载
+            std::atomic<size_t> warm_ { 0 };
+
+            std::atomic<uint64_t> requests_ { 0 };
+            std::atomic<uint64_t> rejected_ { 0 };
+            std::atomic<uint64_t> reconnects_ { 0 };
+            std::atomic<uint64_t> connectFailures_ { 0 };
+            std::atomic<uint64_t> probeFailures_ { 0 };
+
+            // 后台检查在独立线程的io_context上运行，连接状态机只在该线程访问
+            boost::asio::io_context io_context_;
+            boost::asio::steady_timer timer_;
+            std::thread thread_;
+            bool running_ = false;
+            bool stopping_ = false;
+
+            // 把请求交给一个可用连接（任意线程）
+            void send(const std::vector<uint8_t>& frame,
+                      std::chrono::milliseconds timeout,
+                      transport::client::Connection::AdmitHandler admit,
+                      transport::client::Connection::SentHandler onSent,
+                      transport::client::Connection::ResponseHandler handler);
+
+            // 检查所有连接：完成中的连接和关闭操作、断开和空闲探测、到期的重连
+            void onCheck();
+
+            // 排定下一次检查
+            void scheduleCheck();
+
+            // 发出连接
+            void beginConnect(Member& member);
+
+            // 连接建立完成
+            void finishConnect(Member& member, bool connected, std::chrono::steady_clock::time_point now);
+
+            // 关闭连接，关闭完成后重连
+            void beginClose(Member& member);
+
+            // 空闲连接发送探测帧
+            void probe(Member& member);
+        };
+
+    } // namespace service
+} // namespace dlt645
+
+#endif // DLT645_TCP_CLIENT_POOL_H
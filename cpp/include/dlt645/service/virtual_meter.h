@@ -0,0 +1,94 @@
+#ifndef DLT645_VIRTUAL_METER_H
+#define DLT645_VIRTUAL_METER_H
+
+#include "dlt645/model/data_item.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace dlt645 {
+    namespace service {
+
+        // 6字节表计地址打包为整数（低6字节）
+        uint64_t packAddress(std::span<const uint8_t, 6> address);
+        std::array<uint8_t, 6> unpackAddress(uint64_t packed);
+
+        // 虚拟表计：共享DIManager中只读的DI目录，只保存本表计写过的值
+        // 值表为固定容量的开放寻址表（按目录槽位号索引），插入用CAS占位，读写都不加锁；表满后写入失败
+        class VirtualMeter {
+        public:
+            VirtualMeter(uint64_t address, size_t capacity);
+
+            uint64_t address() const { return address_; }
+
+            // 查找本表计中槽位号对应的值，未写过时返回nullptr
+            const model::ValueSlot* find(uint32_t slot) const;
+
+            // 查找或占用槽位号对应的值，表满时返回nullptr
+            model::ValueSlot* findOrInsert(uint32_t slot);
+
+            // 值表容量
+            size_t capacity() const { return mask_ + 1; }
+
+            // 值表中每个条目的字节数
+            static constexpr size_t entrySize() { return sizeof(Entry); }
+
+        private:
+            static constexpr uint32_t EMPTY = UINT32_MAX;
+
+            struct Entry {
+                std::atomic<uint32_t> slot { EMPTY };
+                model::ValueSlot value;
+            };
+
+            size_t indexOf(uint32_t slot) const { return static_cast<size_t>(slot * 0x9E3779B1u) & mask_; }
+
+            uint64_t address_;
+            size_t mask_;
+            std::unique_ptr<Entry[]> entries_;
+        };
+
+        // 虚拟表计登记表：按地址查找不加锁（开放寻址表，桶内为表计指针），登记由互斥锁串行化
+        // 容量在构造时确定，不支持删除
+        //
+        // 每个表计的内存约为 sizeof(VirtualMeter) + 值表容量 × 40字节 + 桶数 × 8字节 / maxMeters，
+        // 桶数为不小于2 × maxMeters的2的幂，摊到每个表计2~4个桶（1万个表计时32768个桶，每表约3.3个）；
+        // 默认每表64个值时约2.6KB，1万个表计约26MB；未写过的DI读取DIManager中的共享值，不占表计内存
+        class MeterRegistry {
+        public:
+            // maxMeters为最多登记的表计数，valuesPerMeter为每个表计最多单独保存的值个数（向上取2的幂）
+            explicit MeterRegistry(size_t maxMeters, size_t valuesPerMeter = 64);
+
+            // 登记表计，已存在时返回已有表计，超过容量时返回nullptr
+            VirtualMeter* add(const std::array<uint8_t, 6>& address);
+
+            // 按打包后的地址查找表计（无锁），不存在时返回nullptr
+            VirtualMeter* find(uint64_t address) const;
+
+            // 已登记的表计数
+            size_t size() const { return count_.load(std::memory_order_acquire); }
+
+            // 每个表计占用的字节数（估算，登记表的桶按实际容量摊到maxMeters个表计上）
+            size_t bytesPerMeter() const;
+
+        private:
+            size_t indexOf(uint64_t address) const;
+
+            size_t maxMeters_;
+            size_t valuesPerMeter_;
+            size_t mask_;
+            std::unique_ptr<std::atomic<VirtualMeter*>[]> buckets_;
+            std::vector<std::unique_ptr<VirtualMeter>> meters_; // 仅在mutex_保护下修改
+            std::atomic<size_t> count_ { 0 };
+            std::mutex mutex_;
+        };
+
+    } // namespace service
+} // namespace dlt645
+
+#endif // DLT645_VIRTUAL_METER_H
@@ -6,8 +6,11 @@
 #include <memory>
 #include <chrono>
 #include <string>
+#include <functional>
 #include <future>
 #include <boost/asio.hpp>
+#include "dlt645/transport/io_context_pool.h"
+#include "dlt645/transport/rtu_timing.h"
 
 namespace dlt645 {
     namespace transport {
@@ -28,8 +31,53 @@ namespace dlt645 {
                 // 断开连接（异步）
                 virtual std::future<void> disconnectAsync() = 0;
 
+                // 响应回调：参数为响应帧，空表示失败（未连接、超时或连接断开），在连接的IO线程中调用
+                using ResponseHandler = std::function<void(std::vector<uint8_t>)>;
+
+                // 发送请求，响应到达或失败时调用handler（不经过promise/future，供协程等异步接口使用）
+                // timeout为本请求的应答超时，0表示使用连接的超时设置；多个表计共用一个连接时各自传入，不必修改连接设置
+                virtual void sendRequestAsync(const std::vector<uint8_t>& frame, std::chrono::milliseconds timeout, ResponseHandler handler) = 0;
+
+                // 发出回调：参数为请求实际发出（开始计算应答超时）的时刻，不含在连接或总线上排队的时间
+                using SentHandler = std::function<void(std::chrono::steady_clock::time_point)>;
+
+                // 放行回调：请求排队结束、即将发出时调用，返回false时请求不发出，直接以空响应结束
+                using AdmitHandler = std::function<bool()>;
+
+                // 发送请求，即将发出时调用admit（可为空），实际发出时调用onSent（可为空，先于handler调用，请求未能发出时不调用），
+                // 响应到达或失败时调用handler；供按往返时延调整超时、熔断的调用方使用。
+                // 默认实现不区分排队和发出，提交时即视为发出
+                virtual void sendRequestAsync(const std::vector<uint8_t>& frame,
+                                              std::chrono::milliseconds timeout,
+                                              AdmitHandler admit,
+                                              SentHandler onSent,
+                                              ResponseHandler handler)
+                {
+                    if (admit && !admit()) {
+                        handler({});
+                        return;
+                    }
+                    if (onSent) {
+                        onSent(std::chrono::steady_clock::now());
+                    }
+                    sendRequestAsync(frame, timeout, std::move(handler));
+                }
+
+                // 发送请求，使用连接的超时设置
+                void sendRequestAsync(const std::vector<uint8_t>& frame, ResponseHandler handler)
+                {
+                    sendRequestAsync(frame, std::chrono::milliseconds(0), std::move(handler));
+                }
+
                 // 发送请求并等待响应（异步）
-                virtual std::future<std::vector<uint8_t>> sendRequestAsync(const std::vector<uint8_t>& frame) = 0;
+                std::future<std::vector<uint8_t>> sendRequestAsync(const std::vector<uint8_t>& frame,
+                                                                   std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+                {
+                    auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+                    auto future = promise->get_future();
+                    sendRequestAsync(frame, timeout, [promise](std::vector<uint8_t> response) { promise->set_value(std::move(response)); });
+                    return future;
+                }
 
                 // 检查连接状态
                 virtual bool isConnected() const = 0;
@@ -50,7 +98,10 @@ namespace dlt645 {
                 void disconnect() { disconnectAsync().get(); }
 
                 // 同步发送请求
-                std::vector<uint8_t> sendRequest(const std::vector<uint8_t>& frame) { return sendRequestAsync(frame).get(); }
+                std::vector<uint8_t> sendRequest(const std::vector<uint8_t>& frame, std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+                {
+                    return sendRequestAsync(frame, timeout).get();
+                }
             };
 
             // 客户端配置基类
@@ -62,6 +113,9 @@ namespace dlt645 {
             struct TcpClientConfig : public ClientConfig {
                 std::string ip = "127.0.0.1";
                 uint16_t port = 10521;
+                // 流水线窗口：同一连接上同时等待响应的最大请求数，超出的请求排队；
+                // 响应按地址、控制码和数据标识与请求匹配，timeout对每个请求从发出时单独计时
+                size_t maxInFlight = 1;
             };
 
             // RTU客户端配置
@@ -72,12 +126,18 @@ namespace dlt645 {
                 int stopBits = 1;
                 std::string parity = "none"; // "none", "even", "odd"
                 int flowControl = 0;         // 0: none, 1: software, 2: hardware
+                // 字节间静默阈值：响应帧未收完时超过该时间没有新字节，按帧被截断处理，0表示按线路参数自动计算（见RtuTiming）
+                std::chrono::milliseconds interCharTimeout { 0 };
+                // 收发切换间隔：收到最后一个字节后至少等待该时间再发送下一个请求，0表示按线路参数自动计算
+                std::chrono::microseconds turnaroundDelay { 0 };
             };
 
-            // TCP客户端实现
-            class TcpClient : public Connection {
+            // TCP客户端实现（须由shared_ptr持有：异步操作的回调持有本对象，可在任意线程析构）
+            class TcpClient : public Connection, public std::enable_shared_from_this<TcpClient> {
             public:
-                TcpClient();
+                // pool非空时在共享的io_context池上运行（按轮询分配一个io_context），不再为每个连接单独创建IO线程
+                // 此时不能在池的IO线程中调用同步接口（connect/sendRequest等）
+                explicit TcpClient(std::shared_ptr<IoContextPool> pool = nullptr);
                 ~TcpClient();
 
                 // 配置TCP客户端
@@ -86,25 +146,60 @@ namespace dlt645 {
                 // 实现Connection接口
                 std::future<bool> connectAsync() override;
                 std::future<void> disconnectAsync() override;
-                std::future<std::vector<uint8_t>> sendRequestAsync(const std::vector<uint8_t>& frame) override;
+                using Connection::sendRequestAsync;
+                void sendRequestAsync(const std::vector<uint8_t>& frame, std::chrono::milliseconds timeout, ResponseHandler handler) override;
+                // 请求从窗口外的队列移入发送队列前调用admit，开始计算应答超时时调用onSent
+                void sendRequestAsync(const std::vector<uint8_t>& frame,
+                                      std::chrono::milliseconds timeout,
+                                      AdmitHandler admit,
+                                      SentHandler onSent,
+                                      ResponseHandler handler) override;
                 bool isConnected() const override;
                 void setTimeout(std::chrono::milliseconds timeout) override;
 
             private:
+                // 一个请求及其响应承诺、超时定时器
+                struct Request;
+
+                // 一次连接的流水线状态（只在IO线程访问）：排队和已发出的请求、发送队列、响应帧解码器
+                struct Pipeline;
+
                 TcpClientConfig config_;
+                std::shared_ptr<IoContextPool> pool_; // 共享的io_context池（为空时使用独占的IO线程）
                 std::shared_ptr<boost::asio::io_context> io_context_;
                 std::unique_ptr<boost::asio::ip::tcp::socket> socket_;
                 std::atomic<bool> isConnected_;
                 std::thread io_thread_;
+                std::shared_ptr<Pipeline> pipeline_; // 当前连接的流水线（只在IO线程访问）
 
                 // 确保io_context运行
                 void ensureIoContextRunning();
+
+                // 窗口未满时把排队的请求移入发送队列
+                void pump(const std::shared_ptr<Pipeline>& pipeline);
+
+                // 发送队列中的请求（同一时刻只有一个写操作）
+                void flush(const std::shared_ptr<Pipeline>& pipeline);
+
+                // 持续读取响应并与已发出的请求匹配
+                void readLoop(const std::shared_ptr<Pipeline>& pipeline);
+
+                // 处理一次读取的结果
+                void onRead(const std::shared_ptr<Pipeline>& pipeline, const boost::system::error_code& error, std::size_t bytes_read);
+
+                // 结束请求并交付响应（空表示失败）
+                static void complete(const std::shared_ptr<Request>& request, std::vector<uint8_t> response);
+
+                // 连接断开时结束所有未完成的请求（不访问本对象，析构后的读回调也可调用）
+                static void failAll(const std::shared_ptr<Pipeline>& pipeline);
             };
 
-            // RTU客户端实现
-            class RtuClient : public Connection {
+            // RTU客户端实现（须由shared_ptr持有：异步操作的回调持有本对象，可在任意线程析构）
+            class RtuClient : public Connection, public std::enable_shared_from_this<RtuClient> {
             public:
-                RtuClient();
+                // pool非空时在共享的io_context池上运行（按轮询分配一个io_context），不再为每个连接单独创建IO线程
+                // 此时不能在池的IO线程中调用同步接口（connect/sendRequest等）
+                explicit RtuClient(std::shared_ptr<IoContextPool> pool = nullptr);
                 ~RtuClient();
 
                 // 配置RTU客户端
@@ -113,22 +208,44 @@ namespace dlt645 {
                 // 实现Connection接口
                 std::future<bool> connectAsync() override;
                 std::future<void> disconnectAsync() override;
-                std::future<std::vector<uint8_t>> sendRequestAsync(const std::vector<uint8_t>& frame) override;
+                using Connection::sendRequestAsync;
+                void sendRequestAsync(const std::vector<uint8_t>& frame, std::chrono::milliseconds timeout, ResponseHandler handler) override;
+                // 收发切换间隔满、写入串口前调用admit，请求在线路上发完（开始计算应答超时）时调用onSent，参数为发完的时刻
+                void sendRequestAsync(const std::vector<uint8_t>& frame,
+                                      std::chrono::milliseconds timeout,
+                                      AdmitHandler admit,
+                                      SentHandler onSent,
+                                      ResponseHandler handler) override;
                 bool isConnected() const override;
                 void setTimeout(std::chrono::milliseconds timeout) override;
 
             private:
+                // 一次请求-响应交换的状态
+                struct Exchange;
+
                 RtuClientConfig config_;
+                RtuTiming timing_;
+                std::shared_ptr<IoContextPool> pool_; // 共享的io_context池（为空时使用独占的IO线程）
                 std::shared_ptr<boost::asio::io_context> io_context_;
                 std::unique_ptr<boost::asio::serial_port> serial_port_;
                 std::atomic<bool> isConnected_;
                 std::thread io_thread_;
+                std::chrono::steady_clock::time_point lastReceive_; // 最后收到字节的时刻（只在IO线程访问）
 
                 // 确保io_context运行
                 void ensureIoContextRunning();
 
                 // 配置串口参数
                 bool configureSerialPort(boost::asio::serial_port& port, const RtuClientConfig& config);
+
+                // 收发切换间隔满后发送请求
+                void transmit(const std::shared_ptr<Exchange>& exchange);
+
+                // 接收响应直到解出完整帧、字节间静默超时或应答超时
+                void receive(const std::shared_ptr<Exchange>& exchange);
+
+                // 结束交换并交付响应（空表示失败）
+                void finish(const std::shared_ptr<Exchange>& exchange, std::vector<uint8_t> response);
             };
 
         } // namespace client
@@ -0,0 +1,55 @@
+#ifndef DLT645_IO_CONTEXT_POOL_H
+#define DLT645_IO_CONTEXT_POOL_H
+
+#include <boost/asio.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace dlt645
+{
+    namespace transport
+    {
+
+        // io_context池：每个线程运行一个独立的io_context（每核一个事件循环）
+        // 同一个socket的所有异步操作都在其所属io_context的唯一线程上完成，连接内部无需加锁
+        class IoContextPool
+        {
+        public:
+            // size为线程数，0表示按CPU核数
+            explicit IoContextPool(size_t size = 1);
+            ~IoContextPool();
+
+            IoContextPool(const IoContextPool &) = delete;
+            IoContextPool &operator=(const IoContextPool &) = delete;
+
+            // 启动所有线程（可在stop后再次调用）
+            void run();
+
+            // 停止所有io_context并等待线程退出
+            void stop();
+
+            // 按轮询选取下一个io_context，用于分配新连接
+            boost::asio::io_context &next();
+
+            // 第index个io_context
+            boost::asio::io_context &at(size_t index) { return *contexts_[index]; }
+
+            // 线程数
+            size_t size() const { return contexts_.size(); }
+
+        private:
+            using WorkGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+
+            std::vector<std::unique_ptr<boost::asio::io_context>> contexts_;
+            std::vector<WorkGuard> workGuards_;
+            std::vector<std::thread> threads_;
+            std::atomic<size_t> next_{0};
+        };
+
+    } // namespace transport
+} // namespace dlt645
+
+#endif // DLT645_IO_CONTEXT_POOL_H
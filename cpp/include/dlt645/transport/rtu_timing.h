@@ -0,0 +1,50 @@
+#ifndef DLT645_RTU_TIMING_H
+#define DLT645_RTU_TIMING_H
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+namespace dlt645
+{
+    namespace transport
+    {
+
+        // 串口总线时序：按波特率和字符格式（起始位+数据位+校验位+停止位）计算字符时间
+        // 帧是否收完由帧长度域判定，字节间静默只用来发现被截断的帧；应答前的收发切换间隔保证对端已释放RS-485总线
+        class RtuTiming
+        {
+        public:
+            // 字节间静默阈值默认取10个字符时间，不小于MIN_SILENCE（USB转串口等适配器会把字节攒批上送）
+            static constexpr size_t SILENCE_CHARS = 10;
+            static constexpr std::chrono::milliseconds MIN_SILENCE { 20 };
+
+            // 收发切换间隔默认取4个字符时间
+            static constexpr size_t TURNAROUND_CHARS = 4;
+
+            RtuTiming(int baudRate = 9600, int dataBits = 8, int stopBits = 1, std::string_view parity = "none");
+
+            // 每个字符的位数
+            int bitsPerChar() const { return bitsPerChar_; }
+
+            // 一个字符的传输时间
+            std::chrono::nanoseconds charTime() const { return charTime_; }
+
+            // chars个字符在线路上的传输时间
+            std::chrono::nanoseconds transmitTime(size_t chars) const { return charTime_ * chars; }
+
+            // 字节间静默阈值，configured大于0时使用配置值
+            std::chrono::nanoseconds silence(std::chrono::milliseconds configured) const;
+
+            // 收到最后一个字节到开始发送的最小间隔，configured大于0时使用配置值
+            std::chrono::nanoseconds turnaround(std::chrono::microseconds configured) const;
+
+        private:
+            int bitsPerChar_;
+            std::chrono::nanoseconds charTime_;
+        };
+
+    } // namespace transport
+} // namespace dlt645
+
+#endif // DLT645_RTU_TIMING_H
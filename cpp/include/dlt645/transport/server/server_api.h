@@ -4,11 +4,17 @@
 #include <boost/asio.hpp>
 #include <chrono>
 #include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include "dlt645/protocol/protocol.h"
+#include "dlt645/transport/io_context_pool.h"
+#include "dlt645/transport/rtu_timing.h"
 
 namespace dlt645
 {
@@ -19,6 +25,7 @@ namespace dlt645
 
             // 前向声明
             class TcpServer;
+            class TcpConnection;
             class RtuServer;
 
             // 连接处理器接口定义
@@ -27,8 +34,9 @@ namespace dlt645
             public:
                 virtual ~ConnectionHandler() = default;
 
-                // 处理接收到的数据
-                virtual std::vector<uint8_t> handleRequest(const protocol::Frame &frame) = 0;
+                // 处理接收到的数据（帧视图引用接收缓冲区，仅在调用期间有效），
+                // 响应帧直接写入response（至少 protocol::MAX_ENCODED_LEN 字节），返回写入长度，0表示无响应
+                virtual size_t handleRequest(const protocol::FrameView &frame, std::span<uint8_t> response) = 0;
 
                 // 连接关闭时的回调
                 virtual void onConnectionClosed() = 0;
@@ -40,12 +48,22 @@ namespace dlt645
                 std::chrono::milliseconds timeout = std::chrono::seconds(5); // 默认超时时间5秒
             };
 
-            // TCP服务器配置
+            // 连接数达到上限时的处理策略
+            enum class AdmissionPolicy
+            {
+                Queue,  // 暂停接受，新连接留在内核监听队列中，有连接断开后再接受
+                Reject, // 照常接受，超限的连接立即关闭
+            };
+
+            // TCP服务器配置（timeout为连接空闲超时，超时未收到数据的连接被断开，0表示不检查）
             struct TcpServerConfig : public ServerConfig
             {
                 std::string ip = "0.0.0.0";
                 uint16_t port = 10521;
-                int maxConnections = 10; // 最大连接数
+                int maxConnections = 10; // 最大连接数，0表示不限制
+                AdmissionPolicy admissionPolicy = AdmissionPolicy::Queue;
+                int ioThreads = 1;       // IO线程数（每线程一个io_context，连接按轮询分配），0表示按CPU核数
+                bool reusePort = false;  // 每个io_context各开一个SO_REUSEPORT监听套接字，由内核分散新连接（不支持的平台退化为单个acceptor）
             };
 
             // RTU服务器配置
@@ -57,6 +75,21 @@ namespace dlt645
                 int stopBits = 1;
                 std::string parity = "none"; // "none", "even", "odd"
                 int flowControl = 0;         // 0: none, 1: software, 2: hardware
+                // 字符间超时：未完成的帧超过该时间没有新字节时丢弃，0表示按线路参数自动计算（见RtuTiming）
+                std::chrono::milliseconds interCharTimeout { 0 };
+                // 收发切换间隔：收到请求最后一个字节后至少等待该时间再应答，0表示按线路参数自动计算
+                std::chrono::microseconds turnaroundDelay { 0 };
+            };
+
+            // TCP服务器连接统计
+            struct TcpServerStats
+            {
+                size_t connections = 0;           // 当前连接数
+                size_t peakConnections = 0;       // 历史峰值连接数
+                size_t queuedConnections = 0;     // 已接受、等待空位的连接数
+                uint64_t acceptedConnections = 0; // 累计接受的连接数
+                uint64_t rejectedConnections = 0; // 超过上限被拒绝的连接数
+                uint64_t evictedConnections = 0;  // 空闲超时被断开的连接数
             };
 
             // 服务器接口定义
@@ -94,20 +127,39 @@ namespace dlt645
                 bool isRunning() const override;
                 void setConnectionHandler(std::shared_ptr<ConnectionHandler> handler) override;
 
+                // 连接统计
+                TcpServerStats stats() const;
+
             private:
+                friend class TcpConnection;
+
                 TcpServerConfig config_;
-                std::shared_ptr<boost::asio::io_context> io_context_;
-                std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor_;
+                std::unique_ptr<IoContextPool> pool_;
+                // 单acceptor模式只有一个（运行在第0个io_context上）；reusePort模式下第i个运行在第i个io_context上
+                std::vector<std::unique_ptr<boost::asio::ip::tcp::acceptor>> acceptors_;
                 std::atomic<bool> isRunning_;
-                std::shared_ptr<ConnectionHandler> connectionHandler_;
-                std::thread io_thread_;
-                std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> work_guard_;
+                std::shared_ptr<ConnectionHandler> connectionHandler_; // 各IO线程并发调用，需线程安全
+
+                // 连接登记表，所有字段由connectionsMutex_保护
+                mutable std::mutex connectionsMutex_;
+                std::unordered_set<std::shared_ptr<TcpConnection>> connections_;
+                std::deque<std::shared_ptr<TcpConnection>> waiting_; // 多个acceptor同时接受导致的超限连接，有空位后再启动
+                std::vector<size_t> pausedAcceptors_;                // 因连接数已满而暂停的acceptor
+                TcpServerStats stats_;
+
+                // 创建并监听一个acceptor
+                std::unique_ptr<boost::asio::ip::tcp::acceptor> openAcceptor(boost::asio::io_context &context,
+                                                                             const boost::asio::ip::tcp::endpoint &endpoint,
+                                                                             bool reusePort);
+
+                // 在第index个acceptor上接受连接
+                void acceptConnection(size_t index);
 
-                // 接受连接
-                void acceptConnection();
+                // 准入控制：登记新连接，达到上限时按策略排队或拒绝，并决定是否继续接受
+                void admit(size_t index, boost::asio::ip::tcp::socket socket);
 
-                // 处理客户端连接
-                void handleClient(std::shared_ptr<boost::asio::ip::tcp::socket> socket);
+                // 连接关闭后从登记表移除，启动排队的连接或恢复暂停的acceptor
+                void release(const std::shared_ptr<TcpConnection> &connection, bool evicted);
             };
 
             // RTU服务器实现
@@ -134,7 +186,23 @@ namespace dlt645
                 std::shared_ptr<ConnectionHandler> connectionHandler_;
                 std::thread io_thread_;
                 std::vector<uint8_t> receiveBuffer_;
+                protocol::FrameDecoder decoder_; // 串口字节流解码器
                 std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> work_guard_;
+                RtuTiming timing_;                     // 按线路参数计算的字符时间
+                boost::asio::steady_timer frameTimer_; // 字符间超时定时器，帧未收完时启动
+                boost::asio::steady_timer turnaroundTimer_;          // 收发切换间隔未满时延后发送
+                std::chrono::steady_clock::time_point lastReceive_; // 最后收到字节的时刻
+                bool turnaroundPending_ = false;
+
+                // 发送队列（只在IO线程访问）：outbox_为等待发送的响应，inflight_为正在写的响应，写完后缓冲区回收到spare_
+                static constexpr size_t MAX_QUEUED_FRAMES = 64;
+                static constexpr size_t MAX_SPARE_BUFFERS = 16;
+                std::vector<std::vector<uint8_t>> outbox_;
+                std::vector<std::vector<uint8_t>> inflight_;
+                std::vector<std::vector<uint8_t>> spare_;
+                std::vector<boost::asio::const_buffer> writeBuffers_;
+                bool writing_ = false;
+                bool readPaused_ = false;
 
                 // 配置串口参数
                 bool configureSerialPort(boost::asio::serial_port &port, const RtuServerConfig &config);
@@ -144,6 +212,21 @@ namespace dlt645
 
                 // 处理接收到的数据
                 void handleReceive(const boost::system::error_code &error, size_t bytes_transferred);
+
+                // 解出分片中的完整帧，响应放入发送队列
+                void handleFrames(std::span<const uint8_t> received);
+
+                // 帧未收完时启动字符间超时定时器
+                void armFrameTimer();
+
+                // 取出一个可复用的响应缓冲区
+                std::vector<uint8_t> acquireBuffer();
+
+                // 发送队列中的响应（异步写，不阻塞接收）
+                void flush();
+
+                // 写完成回调
+                void onWrite(const boost::system::error_code &error);
             };
 
         } // namespace server
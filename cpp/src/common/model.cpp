@@ -4,23 +4,31 @@
 namespace dlt645 {
 namespace model {
 
-bool isValueValid(const std::string &dataFormat, float value) {
-  if (dataFormat == DataFormat::XXXXXX_XX) {
-    return -799999.99 <= value && value <= 799999.99;
-  } else if (dataFormat == DataFormat::XXXX_XX) {
-    return -7999.99 <= value && value <= 7999.99;
-  } else if (dataFormat == DataFormat::XXX_XXX) {
-    return -799.999 <= value && value <= 799.999;
-  }else if (dataFormat == DataFormat::XXX_X) {
-    return -799.9 <= value && value <= 799.9;
-  }else if(dataFormat == DataFormat::XX_XXXX){
-    return -79.9999 <= value && value <= 79.9999;
-  }else if (dataFormat == DataFormat::XX_XX) {
-    return -79.99 <= value && value <= 79.99;
-  }else if (dataFormat == DataFormat::X_XXX) {
-    return -7.999 <= value && value <= 7.999;
+// 描述表必须按DataFormat取值顺序排列
+static_assert([] {
+  for (size_t i = 0; i < DATA_FORMATS.size(); ++i) {
+    if (static_cast<size_t>(DATA_FORMATS[i].format) != i) {
+      return false;
+    }
   }
-  return false;
+  return true;
+}());
+
+bool isValueValid(DataFormat dataFormat, float value) {
+  const common::BcdFormat &format = bcdFormat(dataFormat);
+  if (format.byteWidth == 0) {
+    return false;
+  }
+  return format.inRange(format.toScaled(value));
+}
+
+DataFormat parseDataFormat(std::string_view name) {
+  for (const auto &info : DATA_FORMATS) {
+    if (info.format != DataFormat::Unknown && info.name == name) {
+      return info.format;
+    }
+  }
+  return DataFormat::Unknown;
 }
 
 } // namespace model
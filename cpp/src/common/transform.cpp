@@ -6,7 +6,7 @@ namespace dlt645 {
     namespace common {
 
         // 字节数组转十六进制字符串
-        std::string bytesToHexString(const std::vector<uint8_t>& bytes, bool uppercase, bool withSpace)
+        std::string bytesToHexString(std::span<const uint8_t> bytes, bool uppercase, bool withSpace)
         {
             std::ostringstream oss;
             oss << std::setfill('0');
@@ -142,152 +142,108 @@ namespace dlt645 {
             return static_cast<uint32_t>(result);
         }
 
-        // 浮点数转换为BCD码（支持大小端序）
-        std::vector<uint8_t> floatToBcd(float value, const std::string& dataFormat, bool littleEndian)
+        // 将缩放后的整数按格式写入BCD码
+        size_t encodeBcd(int64_t scaled, const BcdFormat& format, std::span<uint8_t> out, bool littleEndian)
         {
-            std::vector<uint8_t> bcd;
-
-            // 确定小数位数
-            int decimalPlaces = 0;
-            if (dataFormat.find('.') != std::string::npos) {
-                size_t dotPos = dataFormat.find('.');
-                decimalPlaces = static_cast<int>(dataFormat.length() - dotPos - 1);
-            }
-
-            // 计算缩放因子
-            uint64_t scaleFactor = 1;
-            for (int i = 0; i < decimalPlaces; ++i) {
-                scaleFactor *= 10;
-            }
-
-            // 处理负值：取绝对值，后续可添加符号处理
-            bool isNegative = value < 0;
-            float absValue = std::abs(value);
-
-            // 将浮点数转换为整数（四舍五入）
-            uint64_t intValue = static_cast<uint64_t>(std::round(absValue * scaleFactor));
-
-            // 特殊情况处理：值为0
-            if (intValue == 0) {
-                bcd.push_back(0x00);
-                return bcd;
+            size_t width = format.byteWidth;
+            if (width == 0 || out.size() < width || !format.inRange(scaled)) {
+                return 0;
             }
 
-            // 将整数转换为数字字符串以便处理
-            std::string digits = std::to_string(intValue);
+            bool isNegative = scaled < 0;
+            uint64_t magnitude = isNegative ? static_cast<uint64_t>(-scaled) : static_cast<uint64_t>(scaled);
 
-            // 确保数字位数为偶数，便于BCD编码
-            if (digits.size() % 2 != 0) {
-                digits = "0" + digits; // 前补0
+            // 从低字节开始，每字节存储两位十进制数字
+            for (size_t i = 0; i < width; ++i) {
+                uint8_t pair = static_cast<uint8_t>(magnitude % 100);
+                magnitude /= 100;
+                out[littleEndian ? i : width - 1 - i] = static_cast<uint8_t>(((pair / 10) << 4) | (pair % 10));
             }
 
-            // 转换为BCD码（压缩BCD：每个字节存储两个十进制数字）
-            for (size_t i = 0; i < digits.size(); i += 2) {
-                uint8_t highDigit = static_cast<uint8_t>(digits[i] - '0');
-                uint8_t lowDigit = static_cast<uint8_t>(digits[i + 1] - '0');
-                uint8_t bcdByte = static_cast<uint8_t>((highDigit << 4) | lowDigit);
-                bcd.push_back(bcdByte);
-            }
-
-            // 处理符号位（如果需要）
+            // 符号位位于最高字节的最高位
             if (isNegative) {
-                // 在最高字节添加符号标识，常见做法是最高位设为1
-                if (!bcd.empty()) {
-                    bcd[0] |= 0x80; // 设置最高位为1表示负数
-                }
+                out[littleEndian ? width - 1 : 0] |= 0x80;
             }
-
-            // 补齐到指定字节数
-            while (bcd.size() < 4) {
-                bcd.insert(bcd.begin(), 0x00);
-            }
-
-            // 大小端序处理
-            if (littleEndian) {
-                std::reverse(bcd.begin(), bcd.end());
-            }
-
-            return bcd;
+            return width;
         }
 
-        // BCD码转换为浮点数（支持大小端序）
-        float bcdToFloat(const std::vector<uint8_t>& bcd, const std::string& dataFormat, bool littleEndian)
+        // 按格式解析BCD码
+        std::optional<int64_t> decodeBcd(std::span<const uint8_t> bcd, const BcdFormat& format, bool littleEndian)
         {
-            // 检查输入参数
-            if (bcd.empty()) {
-                return 0.0f;
-            }
-
-            // 确定小数位数
-            int decimalPlaces = 0;
-            if (dataFormat.find('.') != std::string::npos) {
-                size_t dotPos = dataFormat.find('.');
-                decimalPlaces = static_cast<int>(dataFormat.length() - dotPos - 1);
-            }
-
-            // 复制BCD数据以便处理
-            std::vector<uint8_t> bcdCopy = bcd;
-
-            // 处理大小端序
-            if (littleEndian) {
-                std::reverse(bcdCopy.begin(), bcdCopy.end());
+            size_t width = bcd.size();
+            if (width == 0 || width * 2 > BcdFormat::MAX_DIGITS) {
+                return std::nullopt;
             }
 
-            // 处理符号位
+            int64_t result = 0;
             bool isNegative = false;
-            if ((bcdCopy[0] & 0x80) != 0) {
-                isNegative = true;
-                bcdCopy[0] &= 0x7F; // 清除符号位
-            }
 
-            // 将BCD码转换为数字字符串
-            std::string digits;
-            for (uint8_t byte : bcdCopy) {
-                // 提取高位数字
-                uint8_t highDigit = (byte >> 4) & 0x0F;
-                // 提取低位数字
-                uint8_t lowDigit = byte & 0x0F;
-
-                // 检查BCD格式是否有效
-                if (highDigit > 9 || lowDigit > 9) {
-                    return 0.0f; // 无效的BCD格式
+            // 从最高字节开始累加
+            for (size_t i = 0; i < width; ++i) {
+                uint8_t byte = bcd[littleEndian ? width - 1 - i : i];
+                if (i == 0 && format.isSigned) {
+                    isNegative = (byte & 0x80) != 0;
+                    byte &= 0x7F;
                 }
 
-                // 添加到数字字符串
-                digits += (highDigit + '0');
-                digits += (lowDigit + '0');
+                uint8_t high = byte >> 4;
+                uint8_t low = byte & 0x0F;
+                if (high > 9 || low > 9) {
+                    return std::nullopt;
+                }
+                result = result * 100 + high * 10 + low;
             }
 
-            // 移除前导零
-            size_t firstNonZero = digits.find_first_not_of('0');
-            if (firstNonZero != std::string::npos) {
-                digits = digits.substr(firstNonZero);
-            } else {
-                digits = "0"; // 所有位都是零
-            }
+            return isNegative ? -result : result;
+        }
 
-            // 如果数字位数小于小数位数，前面补零
-            while (digits.size() <= static_cast<size_t>(decimalPlaces)) {
-                digits = "0" + digits;
-            }
+        // 浮点数按格式转换为BCD码
+        size_t floatToBcd(float value, const BcdFormat& format, std::span<uint8_t> out, bool littleEndian)
+        {
+            return encodeBcd(format.toScaled(value), format, out, littleEndian);
+        }
 
-            // 插入小数点
-            std::string floatStr;
-            if (decimalPlaces > 0) {
-                floatStr = digits.substr(0, digits.size() - decimalPlaces) + "." + digits.substr(digits.size() - decimalPlaces);
-            } else {
-                floatStr = digits;
+        // BCD码按格式转换为浮点数
+        float bcdToFloat(std::span<const uint8_t> bcd, const BcdFormat& format, bool littleEndian)
+        {
+            auto scaled = decodeBcd(bcd, format, littleEndian);
+            if (!scaled) {
+                return 0.0f;
             }
+            return static_cast<float>(format.fromScaled(*scaled));
+        }
 
-            // 转换为浮点数
-            float result = std::stof(floatStr);
+        // 浮点数转换为BCD码（支持大小端序）
+        std::vector<uint8_t> floatToBcd(float value, const std::string& dataFormat, bool littleEndian)
+        {
+            BcdFormat format = BcdFormat::parse(dataFormat);
+            std::vector<uint8_t> bcd(format.byteWidth);
+            if (floatToBcd(value, format, bcd, littleEndian) > 0) {
+                return bcd;
+            }
 
-            // 应用符号
-            if (isNegative) {
-                result = -result;
+            // 超出格式范围：与原实现一样输出全部数字，按位数加宽（最高字节最高位为符号位）；int64_t无法表示时返回空
+            double scaledValue = static_cast<double>(value) * static_cast<double>(format.scaleFactor());
+            if (!std::isfinite(scaledValue) || std::abs(scaledValue) >= static_cast<double>(BcdFormat::pow10(BcdFormat::MAX_DIGITS))) {
+                return {};
             }
+            int64_t scaled = format.toScaled(value);
+            size_t digits = 1;
+            for (int64_t rest = scaled < 0 ? -scaled : scaled; rest >= 10; rest /= 10) {
+                ++digits;
+            }
+            // 负数的最高半字节要留出符号位
+            size_t width = std::max<size_t>(format.byteWidth, (digits + (scaled < 0 ? 2 : 1)) / 2);
+            BcdFormat wide = BcdFormat::parse(std::string(width * 2, 'X'), scaled < 0);
+            bcd.resize(width);
+            bcd.resize(encodeBcd(scaled, wide, bcd, littleEndian));
+            return bcd;
+        }
 
-            return result;
+        // BCD码转换为浮点数（支持大小端序）
+        float bcdToFloat(const std::vector<uint8_t>& bcd, const std::string& dataFormat, bool littleEndian)
+        {
+            return bcdToFloat(std::span<const uint8_t>(bcd), BcdFormat::parse(dataFormat), littleEndian);
         }
 
         // 时间转换为BCD码
@@ -1,7 +1,9 @@
 #include "dlt645/model/data_item.h"
+#include <bit>
 #include <fstream>
 #include <memory>
 #include <string>
+#include <thread>
 #include "dlt645/common/log.h"
 #include "dlt645/model/model.h"
 #include "util/env.hpp"
@@ -10,26 +12,264 @@
 namespace dlt645 {
     namespace model {
 
+        // 完整名称
+        std::string DataItemMeta::fullName() const
+        {
+            if (settlementDay == NO_SETTLEMENT_DAY) {
+                return std::string(name);
+            }
+            std::string result = settlementDay == 0 ? "（当前）" : "（上" + std::to_string(settlementDay) + "结算日）";
+            result.append(name);
+            return result;
+        }
+
+        // 读取一致的快照
+        LiveValue ValueSlot::load() const
+        {
+            LiveValue result;
+            uint64_t before = 0;
+            uint64_t after = 0;
+            do {
+                before = seq_.load(std::memory_order_acquire);
+                if (before & 1) {
+                    continue; // 写者正在写入
+                }
+                result.kind = static_cast<LiveValue::Kind>(kind_.load(std::memory_order_relaxed));
+                result.bits = value_.load(std::memory_order_relaxed);
+                result.occurTime = std::chrono::system_clock::time_point(
+                    std::chrono::system_clock::duration(occurTime_.load(std::memory_order_relaxed)));
+                result.timestamp = std::chrono::system_clock::time_point(
+                    std::chrono::system_clock::duration(timestamp_.load(std::memory_order_relaxed)));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = seq_.load(std::memory_order_relaxed);
+            } while ((before & 1) || before != after);
+
+            result.value = std::bit_cast<float>(result.bits);
+            result.version = before / 2;
+            return result;
+        }
+
+        // 写入新值并递增版本号
+        void ValueSlot::store(LiveValue::Kind kind,
+                              float value,
+                              std::chrono::system_clock::time_point occurTime,
+                              std::chrono::system_clock::time_point timestamp)
+        {
+            storeBits(kind, std::bit_cast<uint32_t>(value), occurTime, timestamp);
+        }
+
+        // 按位模式写入新值并递增版本号
+        void ValueSlot::storeBits(LiveValue::Kind kind,
+                                  uint32_t bits,
+                                  std::chrono::system_clock::time_point occurTime,
+                                  std::chrono::system_clock::time_point timestamp)
+        {
+            // 将序号从偶数改为奇数以独占写入
+            uint64_t seq = seq_.load(std::memory_order_relaxed);
+            while ((seq & 1) || !seq_.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                seq = seq_.load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+
+            kind_.store(static_cast<uint8_t>(kind), std::memory_order_relaxed);
+            value_.store(bits, std::memory_order_relaxed);
+            occurTime_.store(occurTime.time_since_epoch().count(), std::memory_order_relaxed);
+            timestamp_.store(timestamp.time_since_epoch().count(), std::memory_order_relaxed);
+
+            seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        namespace {
+
+            // 当前线程的读者计数分片，首次使用时按线程轮转分配
+            size_t readerShard(size_t shards)
+            {
+                static std::atomic<size_t> next { 0 };
+                thread_local const size_t shard = next.fetch_add(1, std::memory_order_relaxed);
+                return shard % shards;
+            }
+
+        } // namespace
+
+        // 进入读者区间：计数必须先于索引的加载对写者可见（均为seq_cst）
+        DataItemManager::ReadGuard::ReadGuard(const DataItemManager& manager)
+            : count_(manager.readers_[readerShard(READER_SHARDS)].count[manager.epoch_.load(std::memory_order_seq_cst) & 1])
+        {
+            count_.fetch_add(1, std::memory_order_seq_cst);
+        }
+
+        DataItemManager::ReadGuard::~ReadGuard() { count_.fetch_sub(1, std::memory_order_release); }
+
         // 私有构造函数
         DataItemManager::DataItemManager()
+            : index_(new Index())
         {
             LOG_DEBUG("DataItemManager: Constructor called - starting initialization");
+            std::lock_guard<std::mutex> lock(mutex_);
+
             // 初始化所有类型定义
-            loadTypeDefsFromJson();
+            loadTypeDefs();
 
-            // 初始化电能、需量、变量类型定义
-            initEnergyDef();
-            initDemandDef();
-            initVariablesDef();
+            // 初始化电能、需量类型定义，全部生成后只发布一次索引
+            buildEnergyDefs();
+            buildDemandDefs();
+            publish();
 
             LOG_DEBUG("DataItemManager: Constructor completed - initialization finished");
         }
 
+        DataItemManager::~DataItemManager() { delete index_.load(std::memory_order_acquire); }
+
+        // 宽限期：替换索引后翻转纪元，逐个分片等待旧纪元的计数归零。
+        // 加载到旧索引的读者一定先在旧纪元计数；翻转后进入的读者计入新纪元，只会加载到新索引，不会阻止旧纪元归零
+        void DataItemManager::synchronize()
+        {
+            uint32_t parity = epoch_.fetch_add(1, std::memory_order_seq_cst) & 1;
+            for (auto& shard : readers_) {
+                while (shard.count[parity].load(std::memory_order_seq_cst) != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        // 由写者状态构建新索引并发布
+        void DataItemManager::publish()
+        {
+            auto index = std::make_unique<Index>();
+            index->slots = DiIndex(std::vector<std::pair<uint32_t, uint32_t>>(slotMap_.begin(), slotMap_.end()));
+            index->chunks.reserve(chunks_.size());
+            for (const auto& chunk : chunks_) {
+                index->chunks.push_back(chunk.get());
+            }
+
+            std::unique_ptr<const Index> old(index_.exchange(index.release(), std::memory_order_seq_cst));
+            synchronize();
+
+            // 宽限期后不再有读者持有被替换的元数据
+            freeMetas_.insert(freeMetas_.end(), retiredMetas_.begin(), retiredMetas_.end());
+            retiredMetas_.clear();
+        }
+
+        // 字符串驻留
+        std::string_view DataItemManager::intern(const std::string& str) { return *strings_.insert(str).first; }
+
+        // 写入元数据
+        ValueSlot& DataItemManager::put(const DataItemMeta& meta)
+        {
+            uint32_t slot = 0;
+            if (auto it = slotMap_.find(meta.di); it != slotMap_.end()) {
+                slot = it->second;
+            } else if (auto parked = parked_.find(meta.di); parked != parked_.end()) {
+                // 移除后重新加入的DI沿用原槽位
+                slot = parked->second;
+                parked_.erase(parked);
+                slotMap_.emplace(meta.di, slot);
+            } else {
+                // 新DI：分配新槽位，需要时追加一个块；新槽位在索引发布前对读者不可见
+                slot = nextSlot_++;
+                if ((slot >> CHUNK_SHIFT) >= chunks_.size()) {
+                    chunks_.push_back(std::make_unique<Chunk>());
+                }
+                slotMap_.emplace(meta.di, slot);
+            }
+
+            Chunk& chunk = *chunks_[slot >> CHUNK_SHIFT];
+            uint32_t offset = slot & (CHUNK_SIZE - 1);
+            const DataItemMeta* current = chunk.meta[offset].load(std::memory_order_relaxed);
+            if (current && *current == meta) {
+                // 元数据未变
+                return chunk.values[offset];
+            }
+
+            // 已发布的元数据不可修改（读者可能正在访问）：写入空闲对象后替换指针，旧对象等宽限期后复用
+            DataItemMeta* fresh = nullptr;
+            if (!freeMetas_.empty()) {
+                fresh = freeMetas_.back();
+                freeMetas_.pop_back();
+            } else {
+                fresh = &metas_.emplace_back();
+            }
+            *fresh = meta;
+            chunk.meta[offset].store(fresh, std::memory_order_release);
+            if (current) {
+                retiredMetas_.push_back(const_cast<DataItemMeta*>(current));
+            }
+            return chunk.values[offset];
+        }
+
+        // 写入数据项
+        void DataItemManager::put(const DataItem& dataItem)
+        {
+            ValueSlot& slot
+                = put(DataItemMeta { dataItem.di, dataItem.dataFormat, NO_SETTLEMENT_DAY, intern(dataItem.name), intern(dataItem.unit) });
+            storeValue(slot, dataItem);
+        }
+
+        // 按结算日生成一组数据项
+        void DataItemManager::putSettlementDays(uint32_t baseDi, const DataItem& type, DataFormat dataFormat)
+        {
+            // 13个结算日共用驻留的类型名称，完整名称在读取时再拼接
+            std::string_view name = intern(type.name);
+            std::string_view unit = intern(type.unit);
+            for (uint8_t day = 0; day <= MAX_SETTLEMENT_DAY; ++day) {
+                ValueSlot& slot = put(DataItemMeta { (baseDi & 0xFFFFFF00) | day, dataFormat, day, name, unit });
+                slot.store(LiveValue::Kind::None, 0.0f, {}, {});
+            }
+        }
+
+        // 将DataItem中的值写入槽位
+        bool DataItemManager::storeValue(ValueSlot& slot, const DataItem& dataItem)
+        {
+            if (std::holds_alternative<std::monostate>(dataItem.value)) {
+                slot.store(LiveValue::Kind::None, 0.0f, {}, dataItem.timestamp);
+            } else if (std::holds_alternative<float>(dataItem.value)) {
+                slot.store(LiveValue::Kind::Float, std::get<float>(dataItem.value), {}, dataItem.timestamp);
+            } else if (std::holds_alternative<Demand>(dataItem.value)) {
+                const Demand& demand = std::get<Demand>(dataItem.value);
+                slot.store(LiveValue::Kind::Demand, demand.value, demand.occurTime, dataItem.timestamp);
+            } else if (std::holds_alternative<int32_t>(dataItem.value)) {
+                slot.storeBits(LiveValue::Kind::Int32, std::bit_cast<uint32_t>(std::get<int32_t>(dataItem.value)), {}, dataItem.timestamp);
+            } else if (std::holds_alternative<uint32_t>(dataItem.value)) {
+                slot.storeBits(LiveValue::Kind::UInt32, std::get<uint32_t>(dataItem.value), {}, dataItem.timestamp);
+            } else {
+                LOG_ERROR("String value is not supported for DI {:08X}, value dropped", dataItem.di);
+                return false;
+            }
+            return true;
+        }
+
+        // 由元数据和值快照生成数据项
+        DataItem DataItemManager::toDataItem(const DataItemMeta& meta, const LiveValue& value)
+        {
+            DataItem item;
+            item.di = meta.di;
+            item.name = meta.fullName();
+            item.dataFormat = meta.dataFormat;
+            item.unit = meta.unit;
+            item.timestamp = value.timestamp;
+            if (value.kind == LiveValue::Kind::Float) {
+                item.value = value.value;
+            } else if (value.kind == LiveValue::Kind::Demand) {
+                item.value = Demand(value.value, value.occurTime);
+            } else if (value.kind == LiveValue::Kind::Int32) {
+                item.value = std::bit_cast<int32_t>(value.bits);
+            } else if (value.kind == LiveValue::Kind::UInt32) {
+                item.value = value.bits;
+            }
+            return item;
+        }
+
         // 从JSON文件加载类型定义
         void DataItemManager::loadTypeDefsFromJson()
         {
             std::lock_guard<std::mutex> lock(mutex_);
+            loadTypeDefs();
+            publish();
+        }
 
+        // 从JSON文件加载三种类型定义（调用方持有mutex_）
+        void DataItemManager::loadTypeDefs()
+        {
             // 构建配置文件路径
             std::string variableTypesFile = dataPath() + "variable_types.json";
             std::string energyTypesFile = dataPath() + "energy_types.json";
@@ -37,9 +277,9 @@ namespace dlt645 {
 
             // 加载三种类型定义
             int loadedCount = 0;
-            loadedCount += loadTypeDefsFromFile(energyTypesFile, DataType::Energy);
-            loadedCount += loadTypeDefsFromFile(demandTypesFile, DataType::Demand);
-            loadedCount += loadTypeDefsFromFile(variableTypesFile, DataType::Variable);
+            loadedCount += loadTypeDefs(energyTypesFile, DataType::Energy);
+            loadedCount += loadTypeDefs(demandTypesFile, DataType::Demand);
+            loadedCount += loadTypeDefs(variableTypesFile, DataType::Variable);
 
             LOG_INFO("Total loaded type definitions: {}", loadedCount);
         }
@@ -48,21 +288,36 @@ namespace dlt645 {
         void DataItemManager::addDataItem(uint32_t di, const DataItem& dataItem)
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            diMap_[di] = dataItem;
+            DataItem item = dataItem;
+            item.di = di;
+            put(item);
+            publish();
         }
 
         // 移除数据项类型定义
         void DataItemManager::removeDataItem(uint32_t di)
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            auto it = diMap_.find(di);
-            if (it != diMap_.end()) {
-                diMap_.erase(it);
+            auto it = slotMap_.find(di);
+            if (it != slotMap_.end()) {
+                // 保留槽位（按槽位号索引的外部表不会错配到其他DI），重新加入时沿用
+                parked_.emplace(it->first, it->second);
+                slotMap_.erase(it);
+                publish();
             }
         }
 
         // 从指定JSON文件加载数据项类型定义
         int DataItemManager::loadTypeDefsFromFile(const std::string& filePath, const DataType& dataType)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            int count = loadTypeDefs(filePath, dataType);
+            publish();
+            return count;
+        }
+
+        // 从指定JSON文件加载数据项类型定义（调用方持有mutex_）
+        int DataItemManager::loadTypeDefs(const std::string& filePath, const DataType& dataType)
         {
             int count = 0;
             JsonDoc jsonDoc;
@@ -118,9 +373,13 @@ namespace dlt645 {
                     dataItem.unit = item["Unit"].GetString();
                 }
 
-                // 解析Dataformat (数据格式)
+                // 解析Dataformat (数据格式)，格式串只在加载时转换一次
                 if (item.HasMember("DataFormat") && item["DataFormat"].IsString()) {
-                    dataItem.dataFormat = item["DataFormat"].GetString();
+                    std::string_view formatStr = item["DataFormat"].GetString();
+                    dataItem.dataFormat = parseDataFormat(formatStr);
+                    if (dataItem.dataFormat == DataFormat::Unknown) {
+                        LOG_WARN("Unknown DataFormat: {} for Di {:08X} in {} file", formatStr, dataItem.di, filePath);
+                    }
                 }
 
                 if (dataType == DataType::Energy) {
@@ -131,8 +390,8 @@ namespace dlt645 {
                     variableTypes.push_back(dataItem);
                 }
 
-                // 添加到映射表中
-                diMap_[dataItem.di] = dataItem;
+                // 添加到索引中
+                put(dataItem);
                 count++;
             }
 
@@ -140,44 +399,116 @@ namespace dlt645 {
             return count;
         }
 
-        // 获取所有数据项类型定义
-        const std::unordered_map<uint32_t, DataItem>& DataItemManager::getDataItems() const { return diMap_; }
+        // 获取所有数据项（按当前值生成副本）
+        std::vector<std::shared_ptr<const DataItem>> DataItemManager::getDataItems() const
+        {
+            ReadGuard guard(*this);
+            const Index* index = index_.load(std::memory_order_seq_cst);
+            std::vector<std::shared_ptr<const DataItem>> items;
+            items.reserve(index->slots.size());
+            for (uint32_t slot : index->slots.all().slots) {
+                DataItemRef ref = index->ref(slot);
+                items.push_back(std::make_shared<const DataItem>(toDataItem(*ref.meta, ref.value->load())));
+            }
+            return items;
+        }
 
-        // 根据DI获取数据项类型定义 (保持向后兼容)
-        std::shared_ptr<DataItem> DataItemManager::getDataItem(uint32_t di) const
+        // 根据DI查找数据项（无锁）
+        std::optional<DataItemRef> DataItemManager::find(uint32_t di) const
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            ReadGuard guard(*this);
+            const Index* index = index_.load(std::memory_order_seq_cst);
+            uint32_t slot = index->slots.find(di);
+            if (slot == DiIndex::NPOS) {
+                return std::nullopt;
+            }
+            return index->ref(slot);
+        }
 
-            auto it = diMap_.find(di);
-            if (it != diMap_.end()) {
-                return std::make_shared<DataItem>(it->second);
+        // 查找全部结算日的数据项
+        std::vector<DataItemRef> DataItemManager::findSettlementDays(uint32_t di) const
+        {
+            ReadGuard guard(*this);
+            const Index* index = index_.load(std::memory_order_seq_cst);
+            DiIndex::Range range = index->slots.settlementDays(di);
+            std::vector<DataItemRef> refs;
+            refs.reserve(range.size());
+            for (uint32_t slot : range.slots) {
+                refs.push_back(index->ref(slot));
+            }
+            return refs;
+        }
+
+        // 根据DI获取数据项副本 (保持向后兼容)
+        std::shared_ptr<DataItem> DataItemManager::getDataItem(uint32_t di) const
+        {
+            ReadGuard guard(*this);
+            auto ref = find(di);
+            if (ref) {
+                return std::make_shared<DataItem>(toDataItem(*ref->meta, ref->value->load()));
             }
 
             return nullptr;
         }
 
-        // 根据DI获取可修改的数据项引用
-        bool DataItemManager::updateDataItem(uint32_t di, const DataItem& dataItem)
+        // 根据DI写入浮点值
+        bool DataItemManager::setValue(uint32_t di, float value)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            auto ref = find(di);
+            if (!ref) {
+                return false;
+            }
+            ref->value->store(LiveValue::Kind::Float, value, {}, std::chrono::system_clock::now());
+            return true;
+        }
 
-            auto it = diMap_.find(di);
-            if (it != diMap_.end()) {
-                // 更新原始数据项
-                it->second = dataItem;
-                return true;
+        // 根据DI写入需量值及发生时间
+        bool DataItemManager::setDemand(uint32_t di, const Demand& demand)
+        {
+            auto ref = find(di);
+            if (!ref) {
+                return false;
             }
+            ref->value->store(LiveValue::Kind::Demand, demand.value, demand.occurTime, std::chrono::system_clock::now());
+            return true;
+        }
 
-            return false;
+        // 根据DI更新数据项的值
+        bool DataItemManager::updateDataItem(uint32_t di, const DataItem& dataItem)
+        {
+            auto ref = find(di);
+            if (!ref) {
+                return false;
+            }
+            return storeValue(*ref->value, dataItem);
         }
 
         // 初始化需量类型定义
         void DataItemManager::initDemandDef()
         {
             std::lock_guard<std::mutex> lock(mutex_);
+            buildDemandDefs();
+            publish();
+            LOG_INFO("Demand definitions initialization completed");
+        }
+
+        // 初始化变量类型定义
+        void DataItemManager::initVariablesDef() { std::lock_guard<std::mutex> lock(mutex_); }
+
+        // 初始化电能类型定义
+        void DataItemManager::initEnergyDef()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buildEnergyDefs();
+            publish();
+            LOG_DEBUG("Energy definitions initialized");
+        }
 
+        // 按规则生成需量数据项
+        void DataItemManager::buildDemandDefs()
+        {
             // 需求DI列表
-            std::vector<uint32_t> demandDiList
+            static constexpr uint32_t demandDiList[]
                 = { 0x01150000, 0x01160000, 0x01170000, 0x01180000, 0x01190000, 0x011A0000, 0x011B0000, 0x011C0000,
                     0x011D0000, 0x011E0000, 0x01290000, 0x012A0000, 0x012B0000, 0x012C0000, 0x012D0000, 0x012E0000,
                     0x012F0000, 0x01300000, 0x01310000, 0x01320000, 0x013D0000, 0x013E0000, 0x013F0000, 0x01400000,
@@ -185,169 +516,36 @@ namespace dlt645 {
 
             LOG_INFO("Initializing demand definitions...");
 
-            uint8_t di3 = 0; // 数据类型
-            uint8_t di2 = 0; // 电能类型
-            uint8_t di1 = 0; // 同一类型电能里的不同项
-            uint8_t di0 = 0; // 结算日
-
             // 确保需求类型定义数量足够
-            size_t requiredSize = 64 * 10 + demandDiList.size();
+            size_t requiredSize = RATE_COUNT * DEMAND_GROUPS + std::size(demandDiList);
             if (demandTypes.size() < requiredSize) {
                 LOG_WARN("Not enough demand types loaded, required: {}, actual: {}", requiredSize, demandTypes.size());
-                // 调整循环范围以避免越界
-                requiredSize = demandTypes.size();
             }
 
-            // 遍历并创建需量数据项
-            int demandSize = int(demandTypes.size());
-            for (int i = 0; i < 64 && i < demandSize; ++i) {
-                for (int j = 0; j < 13; ++j) {
-                    std::string namePrefix;
-                    if (j == 0) {
-                        namePrefix = "（当前）";
-                    } else {
-                        namePrefix = "（上" + std::to_string(j) + "结算日）";
-                    }
-
-                    // 数据值默认为monostate
-                    std::variant<std::monostate, float, int32_t, uint32_t, std::string, Demand> defaultValue;
-
-                    // 正向有功需量
-                    uint32_t key = (di3 + 1) << 24 | (di2 + 1) << 16 | (di1 + i) << 8 | (di0 + j);
-                    if (i < demandSize) {
-                        DataItem item(
-                            key, namePrefix + demandTypes[i].name, DataFormat::XX_XXXX, defaultValue, demandTypes[i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 反向有功需量
-                    key = (di3 + 1) << 24 | (di2 + 2) << 16 | (di1 + i) << 8 | (di0 + j);
-                    if (64 + i < demandSize) {
-                        DataItem item(key,
-                                      namePrefix + demandTypes[64 + i].name,
-                                      DataFormat::XX_XXXX,
-                                      defaultValue,
-                                      demandTypes[64 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 组合无功1需量
-                    key = (di3 + 1) << 24 | (di2 + 3) << 16 | (di1 + i) << 8 | (di0 + j);
-                    if (64 * 2 + i < demandSize) {
-                        DataItem item(key,
-                                      namePrefix + demandTypes[64 * 2 + i].name,
-                                      DataFormat::XX_XXXX,
-                                      defaultValue,
-                                      demandTypes[64 * 2 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 组合无功2需量
-                    key = (di3 + 1) << 24 | (di2 + 4) << 16 | (di1 + i) << 8 | (di0 + j);
-                    if (64 * 3 + i < demandSize) {
-                        DataItem item(key,
-                                      namePrefix + demandTypes[64 * 3 + i].name,
-                                      DataFormat::XX_XXXX,
-                                      defaultValue,
-                                      demandTypes[64 * 3 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 第一象限无功费率最大需量
-                    key = (di3 + 1) << 24 | (di2 + 5) << 16 | (di1 + i) << 8 | (di0 + j);
-                    if (64 * 4 + i < demandSize) {
-                        DataItem item(key,
-                                      namePrefix + demandTypes[64 * 4 + i].name,
-                                      DataFormat::XX_XXXX,
-                                      defaultValue,
-                                      demandTypes[64 * 4 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 第二象限无功费率最大需量
-                    key = (di3 + 1) << 24 | (di2 + 6) << 16 | (di1 + i) << 8 | (di0 + j);
-                    if (64 * 5 + i < demandSize) {
-                        DataItem item(key,
-                                      namePrefix + demandTypes[64 * 5 + i].name,
-                                      DataFormat::XX_XXXX,
-                                      defaultValue,
-                                      demandTypes[64 * 5 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 第三象限无功费率最大需量
-                    key = (di3 + 1) << 24 | (di2 + 7) << 16 | (di1 + i) << 8 | (di0 + j);
-                    if (64 * 6 + i < demandSize) {
-                        DataItem item(key,
-                                      namePrefix + demandTypes[64 * 6 + i].name,
-                                      DataFormat::XX_XXXX,
-                                      defaultValue,
-                                      demandTypes[64 * 6 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 第四象限无功费率最大需量
-                    key = (di3 + 1) << 24 | (di2 + 8) << 16 | (di1 + i) << 8 | (di0 + j);
-                    if (64 * 7 + i < demandSize) {
-                        DataItem item(key,
-                                      namePrefix + demandTypes[64 * 7 + i].name,
-                                      DataFormat::XX_XXXX,
-                                      defaultValue,
-                                      demandTypes[64 * 7 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 正向视在最大需量
-                    key = (di3 + 1) << 24 | (di2 + 9) << 16 | (di1 + i) << 8 | (di0 + j);
-                    if (64 * 8 + i < demandSize) {
-                        DataItem item(key,
-                                      namePrefix + demandTypes[64 * 8 + i].name,
-                                      DataFormat::XX_XXXX,
-                                      defaultValue,
-                                      demandTypes[64 * 8 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 反向视在最大需量
-                    key = (di3 + 1) << 24 | (di2 + 10) << 16 | (di1 + i) << 8 | (di0 + j);
-                    if (64 * 9 + i < demandSize) {
-                        DataItem item(key,
-                                      namePrefix + demandTypes[64 * 9 + i].name,
-                                      DataFormat::XX_XXXX,
-                                      defaultValue,
-                                      demandTypes[64 * 9 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 最后几个数据特殊处理
-                    for (int k = 0; k < int(demandDiList.size()); ++k) {
-                        // 提取demandDiList中的前24位，然后添加结算日信息（最后8位）
-                        key = (demandDiList[k] & 0xFFFFFF00) | (di0 + j);
-                        if (64 * 10 + k < demandSize) {
-                            DataItem item(key,
-                                          namePrefix + demandTypes[64 * 10 + k].name,
-                                          DataFormat::XX_XXXX,
-                                          defaultValue,
-                                          demandTypes[64 * 10 + k].unit);
-                            diMap_[key] = item;
-                        }
+            // 费率需量：DI3=01H，DI2为需量类型（01H正向有功 ... 0AH反向视在），DI1为费率，类型定义按DI2分组、每组64项
+            for (uint32_t group = 0; group < DEMAND_GROUPS; ++group) {
+                for (uint32_t rate = 0; rate < RATE_COUNT; ++rate) {
+                    size_t type = group * RATE_COUNT + rate;
+                    if (type < demandTypes.size()) {
+                        putSettlementDays(0x01000000 | (group + 1) << 16 | rate << 8, demandTypes[type], DataFormat::XX_XXXX);
                     }
                 }
             }
 
-            LOG_INFO("Demand definitions initialization completed");
+            // 最后几个数据特殊处理：取demandDiList中的前24位，结算日放在DI0
+            for (size_t k = 0; k < std::size(demandDiList); ++k) {
+                size_t type = RATE_COUNT * DEMAND_GROUPS + k;
+                if (type < demandTypes.size()) {
+                    putSettlementDays(demandDiList[k], demandTypes[type], DataFormat::XX_XXXX);
+                }
+            }
         }
 
-        // 初始化变量类型定义
-        void DataItemManager::initVariablesDef() { std::lock_guard<std::mutex> lock(mutex_); }
-
-        // 初始化电能类型定义
-        void DataItemManager::initEnergyDef()
+        // 按规则生成电能数据项
+        void DataItemManager::buildEnergyDefs()
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-
             // 电能DI列表
-            std::vector<uint32_t> energyDiList
+            static constexpr uint32_t energyDiList[]
                 = { 0x00800000, 0x00810000, 0x00820000, 0x00830000, 0x00840000, 0x00850000, 0x00860000, 0x00150000, 0x00160000,
                     0x00170000, 0x00180000, 0x00190000, 0x001A0000, 0x001B0000, 0x001C0000, 0x001D0000, 0x001E0000, 0x00940000,
                     0x00950000, 0x00960000, 0x00970000, 0x00980000, 0x00990000, 0x009A0000, 0x00290000, 0x002A0000, 0x002B0000,
@@ -358,160 +556,23 @@ namespace dlt645 {
 
             LOG_INFO("Initializing energy definitions...");
 
-            uint8_t di3 = 0; // 数据类型
-            uint8_t di2 = 0; // 电能类型
-            uint8_t di1 = 0; // 同一类型电能里的不同项
-            uint8_t di0 = 0; // 结算日
-
-            // 遍历并创建电能数据项
-            for (int i = 0; i < 64; ++i) {
-                for (int j = 0; j < 13; ++j) {
-                    std::string namePrefix;
-                    if (j == 0) {
-                        namePrefix = "（当前）";
-                    } else {
-                        namePrefix = "（上" + std::to_string(j) + "结算日）";
-                    }
-
-                    // 数据值默认为monostate
-                    std::variant<std::monostate, float, int32_t, uint32_t, std::string, Demand> defaultValue;
-
-                    // 组合有功费率电能
-                    uint32_t key = (di3 << 24) | (di2 << 16) | ((di1 + i) << 8) | (di0 + j);
-                    int energySize = energyTypes.size();
-                    if (i < energySize) {
-                        DataItem item(
-                            key, namePrefix + energyTypes[i].name, DataFormat::XXXXXX_XX, defaultValue, energyTypes[i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 正向有功费率电能
-                    key = (di3 << 24) | ((di2 + 1) << 16) | ((di1 + i) << 8) | (di0 + j);
-                    if (64 + i < energySize) {
-                        DataItem item(key,
-                                      namePrefix + energyTypes[64 + i].name,
-                                      DataFormat::XXXXXX_XX,
-                                      defaultValue,
-                                      energyTypes[64 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 反向有功费率电能
-                    key = (di3 << 24) | ((di2 + 2) << 16) | ((di1 + i) << 8) | (di0 + j);
-                    if (64 * 2 + i < energySize) {
-                        DataItem item(key,
-                                      namePrefix + energyTypes[64 * 2 + i].name,
-                                      DataFormat::XXXXXX_XX,
-                                      defaultValue,
-                                      energyTypes[64 * 2 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 组合无功1费率电能
-                    key = (di3 << 24) | ((di2 + 3) << 16) | ((di1 + i) << 8) | (di0 + j);
-                    if (64 * 3 + i < energySize) {
-                        DataItem item(key,
-                                      namePrefix + energyTypes[64 * 3 + i].name,
-                                      DataFormat::XXXXXX_XX,
-                                      defaultValue,
-                                      energyTypes[64 * 3 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 组合无功2费率电能
-                    key = (di3 << 24) | ((di2 + 4) << 16) | ((di1 + i) << 8) | (di0 + j);
-                    if (64 * 4 + i < energySize) {
-                        DataItem item(key,
-                                      namePrefix + energyTypes[64 * 4 + i].name,
-                                      DataFormat::XXXXXX_XX,
-                                      defaultValue,
-                                      energyTypes[64 * 4 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 第一象限无功电能
-                    key = (di3 << 24) | ((di2 + 5) << 16) | ((di1 + i) << 8) | (di0 + j);
-                    if (64 * 5 + i < energySize) {
-                        DataItem item(key,
-                                      namePrefix + energyTypes[64 * 5 + i].name,
-                                      DataFormat::XXXXXX_XX,
-                                      defaultValue,
-                                      energyTypes[64 * 5 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 第二象限无功电能
-                    key = (di3 << 24) | ((di2 + 6) << 16) | ((di1 + i) << 8) | (di0 + j);
-                    if (64 * 6 + i < energySize) {
-                        DataItem item(key,
-                                      namePrefix + energyTypes[64 * 6 + i].name,
-                                      DataFormat::XXXXXX_XX,
-                                      defaultValue,
-                                      energyTypes[64 * 6 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 第三象限无功电能
-                    key = (di3 << 24) | ((di2 + 7) << 16) | ((di1 + i) << 8) | (di0 + j);
-                    if (64 * 7 + i < energySize) {
-                        DataItem item(key,
-                                      namePrefix + energyTypes[64 * 7 + i].name,
-                                      DataFormat::XXXXXX_XX,
-                                      defaultValue,
-                                      energyTypes[64 * 7 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 第四象限无功电能
-                    key = (di3 << 24) | ((di2 + 8) << 16) | ((di1 + i) << 8) | (di0 + j);
-                    if (64 * 8 + i < energySize) {
-                        DataItem item(key,
-                                      namePrefix + energyTypes[64 * 8 + i].name,
-                                      DataFormat::XXXXXX_XX,
-                                      defaultValue,
-                                      energyTypes[64 * 8 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 正向视在电能
-                    key = (di3 << 24) | ((di2 + 9) << 16) | ((di1 + i) << 8) | (di0 + j);
-                    if (64 * 9 + i < energySize) {
-                        DataItem item(key,
-                                      namePrefix + energyTypes[64 * 9 + i].name,
-                                      DataFormat::XXXXXX_XX,
-                                      defaultValue,
-                                      energyTypes[64 * 9 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 反向视在电能
-                    key = (di3 << 24) | ((di2 + 10) << 16) | ((di1 + i) << 8) | (di0 + j);
-                    if (64 * 10 + i < energySize) {
-                        DataItem item(key,
-                                      namePrefix + energyTypes[64 * 10 + i].name,
-                                      DataFormat::XXXXXX_XX,
-                                      defaultValue,
-                                      energyTypes[64 * 10 + i].unit);
-                        diMap_[key] = item;
-                    }
-
-                    // 最后几个数据特殊处理
-                    for (int k = 0; k < int(energyDiList.size()); ++k) {
-                        // 提取energyDiList中的前24位，然后添加结算日信息（最后8位）
-                        key = (energyDiList[k] & 0xFFFFFF00) | (di0 + j);
-                        if (64 * 11 + k < energySize) {
-                            DataItem item(key,
-                                          namePrefix + energyTypes[64 * 11 + k].name,
-                                          DataFormat::XXXXXX_XX,
-                                          defaultValue,
-                                          energyTypes[64 * 11 + k].unit);
-                            diMap_[key] = item;
-                        }
+            // 费率电能：DI3=00H，DI2为电能类型（00H组合有功 ... 0AH反向视在），DI1为费率，类型定义按DI2分组、每组64项
+            for (uint32_t group = 0; group < ENERGY_GROUPS; ++group) {
+                for (uint32_t rate = 0; rate < RATE_COUNT; ++rate) {
+                    size_t type = group * RATE_COUNT + rate;
+                    if (type < energyTypes.size()) {
+                        putSettlementDays(group << 16 | rate << 8, energyTypes[type], DataFormat::XXXXXX_XX);
                     }
                 }
             }
 
-            LOG_DEBUG("Energy definitions initialized");
+            // 最后几个数据特殊处理：取energyDiList中的前24位，结算日放在DI0
+            for (size_t k = 0; k < std::size(energyDiList); ++k) {
+                size_t type = RATE_COUNT * ENERGY_GROUPS + k;
+                if (type < energyTypes.size()) {
+                    putSettlementDays(energyDiList[k], energyTypes[type], DataFormat::XXXXXX_XX);
+                }
+            }
         }
 
     } // namespace model
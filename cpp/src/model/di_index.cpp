@@ -0,0 +1,51 @@
+#include "dlt645/model/di_index.h"
+#include <algorithm>
+#include <bit>
+
+namespace dlt645 {
+    namespace model {
+
+        // 构建索引
+        DiIndex::DiIndex(std::vector<std::pair<uint32_t, uint32_t>> entries)
+        {
+            if (entries.empty()) {
+                return;
+            }
+
+            // 升序数组，用于范围查询
+            std::ranges::sort(entries);
+            dis_.reserve(entries.size());
+            slots_.reserve(entries.size());
+            for (const auto& [di, slot] : entries) {
+                dis_.push_back(di);
+                slots_.push_back(slot);
+            }
+
+            // 哈希表容量取2的幂，负载因子不超过1/2，探测链保持很短
+            size_t capacity = std::bit_ceil(entries.size() * 2);
+            buckets_.resize(capacity);
+            mask_ = capacity - 1;
+            shift_ = 32 - static_cast<uint32_t>(std::countr_zero(capacity));
+
+            for (const auto& [di, slot] : entries) {
+                size_t pos = hash(di);
+                while (buckets_[pos].slot != NPOS) {
+                    pos = (pos + 1) & mask_;
+                }
+                buckets_[pos] = { di, slot };
+            }
+        }
+
+        // DI在[first, last]范围内的全部数据项
+        DiIndex::Range DiIndex::range(uint32_t first, uint32_t last) const
+        {
+            auto begin = std::ranges::lower_bound(dis_, first);
+            auto end = std::ranges::upper_bound(begin, dis_.end(), last);
+            size_t offset = static_cast<size_t>(begin - dis_.begin());
+            size_t count = static_cast<size_t>(end - begin);
+            return { std::span<const uint32_t>(dis_).subspan(offset, count),
+                     std::span<const uint32_t>(slots_).subspan(offset, count) };
+        }
+
+    } // namespace model
+} // namespace dlt645
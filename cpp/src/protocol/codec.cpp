@@ -0,0 +1,330 @@
+#include "dlt645/protocol/codec.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DLT645_CODEC_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DLT645_CODEC_SSE2 1
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define DLT645_CODEC_AVX2 1
+#define DLT645_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER)
+#define DLT645_CODEC_AVX2 1
+#define DLT645_TARGET_AVX2
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DLT645_CODEC_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace dlt645
+{
+    namespace protocol
+    {
+        namespace codec
+        {
+            namespace
+            {
+                constexpr uint8_t DATA_OFFSET = 0x33;
+
+                // 短于一个向量宽度的数据直接走标量路径，避免间接调用开销
+                constexpr size_t MIN_VECTOR_LEN = 16;
+
+                uint8_t scalarEncode(const uint8_t *in, uint8_t *out, size_t n)
+                {
+                    uint8_t s = 0;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        uint8_t b = static_cast<uint8_t>(in[i] + DATA_OFFSET);
+                        out[i] = b;
+                        s = static_cast<uint8_t>(s + b);
+                    }
+                    return s;
+                }
+
+                uint8_t scalarDecode(const uint8_t *in, uint8_t *out, size_t n)
+                {
+                    uint8_t s = 0;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        uint8_t b = in[i];
+                        s = static_cast<uint8_t>(s + b);
+                        out[i] = static_cast<uint8_t>(b - DATA_OFFSET);
+                    }
+                    return s;
+                }
+
+                uint8_t scalarSum(const uint8_t *in, size_t n)
+                {
+                    uint8_t s = 0;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        s = static_cast<uint8_t>(s + in[i]);
+                    }
+                    return s;
+                }
+
+#ifdef DLT645_CODEC_SSE2
+                // 按字节回绕累加的16路和 -> 模256总和
+                inline uint8_t hsum128(__m128i acc)
+                {
+                    __m128i sad = _mm_sad_epu8(acc, _mm_setzero_si128());
+                    return static_cast<uint8_t>(_mm_cvtsi128_si32(sad) + _mm_extract_epi16(sad, 4));
+                }
+
+                uint8_t sse2Encode(const uint8_t *in, uint8_t *out, size_t n)
+                {
+                    const __m128i k = _mm_set1_epi8(static_cast<char>(DATA_OFFSET));
+                    __m128i acc = _mm_setzero_si128();
+                    size_t i = 0;
+                    for (; i + 16 <= n; i += 16)
+                    {
+                        __m128i v = _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)), k);
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), v);
+                        acc = _mm_add_epi8(acc, v);
+                    }
+                    return static_cast<uint8_t>(hsum128(acc) + scalarEncode(in + i, out + i, n - i));
+                }
+
+                uint8_t sse2Decode(const uint8_t *in, uint8_t *out, size_t n)
+                {
+                    const __m128i k = _mm_set1_epi8(static_cast<char>(DATA_OFFSET));
+                    __m128i acc = _mm_setzero_si128();
+                    size_t i = 0;
+                    for (; i + 16 <= n; i += 16)
+                    {
+                        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                        acc = _mm_add_epi8(acc, v);
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_sub_epi8(v, k));
+                    }
+                    return static_cast<uint8_t>(hsum128(acc) + scalarDecode(in + i, out + i, n - i));
+                }
+
+                uint8_t sse2Sum(const uint8_t *in, size_t n)
+                {
+                    __m128i acc = _mm_setzero_si128();
+                    size_t i = 0;
+                    for (; i + 16 <= n; i += 16)
+                    {
+                        acc = _mm_add_epi8(acc, _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+                    }
+                    return static_cast<uint8_t>(hsum128(acc) + scalarSum(in + i, n - i));
+                }
+#endif
+
+#ifdef DLT645_CODEC_AVX2
+                DLT645_TARGET_AVX2 inline uint8_t hsum256(__m256i acc)
+                {
+                    __m256i sad = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+                    __m128i s = _mm_add_epi64(_mm256_castsi256_si128(sad), _mm256_extracti128_si256(sad, 1));
+                    return static_cast<uint8_t>(_mm_cvtsi128_si32(s) + _mm_extract_epi16(s, 4));
+                }
+
+                DLT645_TARGET_AVX2 uint8_t avx2Encode(const uint8_t *in, uint8_t *out, size_t n)
+                {
+                    const __m256i k = _mm256_set1_epi8(static_cast<char>(DATA_OFFSET));
+                    __m256i acc = _mm256_setzero_si256();
+                    size_t i = 0;
+                    for (; i + 32 <= n; i += 32)
+                    {
+                        __m256i v = _mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)), k);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), v);
+                        acc = _mm256_add_epi8(acc, v);
+                    }
+                    return static_cast<uint8_t>(hsum256(acc) + scalarEncode(in + i, out + i, n - i));
+                }
+
+                DLT645_TARGET_AVX2 uint8_t avx2Decode(const uint8_t *in, uint8_t *out, size_t n)
+                {
+                    const __m256i k = _mm256_set1_epi8(static_cast<char>(DATA_OFFSET));
+                    __m256i acc = _mm256_setzero_si256();
+                    size_t i = 0;
+                    for (; i + 32 <= n; i += 32)
+                    {
+                        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+                        acc = _mm256_add_epi8(acc, v);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_sub_epi8(v, k));
+                    }
+                    return static_cast<uint8_t>(hsum256(acc) + scalarDecode(in + i, out + i, n - i));
+                }
+
+                DLT645_TARGET_AVX2 uint8_t avx2Sum(const uint8_t *in, size_t n)
+                {
+                    __m256i acc = _mm256_setzero_si256();
+                    size_t i = 0;
+                    for (; i + 32 <= n; i += 32)
+                    {
+                        acc = _mm256_add_epi8(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)));
+                    }
+                    return static_cast<uint8_t>(hsum256(acc) + scalarSum(in + i, n - i));
+                }
+
+                // 检测CPU及操作系统是否支持AVX2
+                bool cpuHasAvx2()
+                {
+#if defined(__GNUC__) || defined(__clang__)
+                    __builtin_cpu_init();
+                    return __builtin_cpu_supports("avx2");
+#else
+                    int info[4] = { 0 };
+                    __cpuid(info, 1);
+                    bool osxsave = (info[2] & (1 << 27)) != 0;
+                    bool avx = (info[2] & (1 << 28)) != 0;
+                    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+                    {
+                        return false;
+                    }
+                    __cpuidex(info, 7, 0);
+                    return (info[1] & (1 << 5)) != 0;
+#endif
+                }
+#endif
+
+#ifdef DLT645_CODEC_NEON
+                uint8_t neonEncode(const uint8_t *in, uint8_t *out, size_t n)
+                {
+                    const uint8x16_t k = vdupq_n_u8(DATA_OFFSET);
+                    uint8x16_t acc = vdupq_n_u8(0);
+                    size_t i = 0;
+                    for (; i + 16 <= n; i += 16)
+                    {
+                        uint8x16_t v = vaddq_u8(vld1q_u8(in + i), k);
+                        vst1q_u8(out + i, v);
+                        acc = vaddq_u8(acc, v);
+                    }
+                    return static_cast<uint8_t>(vaddlvq_u8(acc) + scalarEncode(in + i, out + i, n - i));
+                }
+
+                uint8_t neonDecode(const uint8_t *in, uint8_t *out, size_t n)
+                {
+                    const uint8x16_t k = vdupq_n_u8(DATA_OFFSET);
+                    uint8x16_t acc = vdupq_n_u8(0);
+                    size_t i = 0;
+                    for (; i + 16 <= n; i += 16)
+                    {
+                        uint8x16_t v = vld1q_u8(in + i);
+                        acc = vaddq_u8(acc, v);
+                        vst1q_u8(out + i, vsubq_u8(v, k));
+                    }
+                    return static_cast<uint8_t>(vaddlvq_u8(acc) + scalarDecode(in + i, out + i, n - i));
+                }
+
+                uint8_t neonSum(const uint8_t *in, size_t n)
+                {
+                    uint8x16_t acc = vdupq_n_u8(0);
+                    size_t i = 0;
+                    for (; i + 16 <= n; i += 16)
+                    {
+                        acc = vaddq_u8(acc, vld1q_u8(in + i));
+                    }
+                    return static_cast<uint8_t>(vaddlvq_u8(acc) + scalarSum(in + i, n - i));
+                }
+#endif
+
+                const Kernel SCALAR_KERNEL = { "scalar", scalarEncode, scalarDecode, scalarSum };
+#ifdef DLT645_CODEC_SSE2
+                const Kernel SSE2_KERNEL = { "sse2", sse2Encode, sse2Decode, sse2Sum };
+#endif
+#ifdef DLT645_CODEC_AVX2
+                const Kernel AVX2_KERNEL = { "avx2", avx2Encode, avx2Decode, avx2Sum };
+#endif
+#ifdef DLT645_CODEC_NEON
+                const Kernel NEON_KERNEL = { "neon", neonEncode, neonDecode, neonSum };
+#endif
+
+                // 选择当前CPU上最快的实现
+                const Kernel &selectKernel()
+                {
+#ifdef DLT645_CODEC_AVX2
+                    if (cpuHasAvx2())
+                    {
+                        return AVX2_KERNEL;
+                    }
+#endif
+#ifdef DLT645_CODEC_SSE2
+                    return SSE2_KERNEL;
+#elif defined(DLT645_CODEC_NEON)
+                    return NEON_KERNEL;
+#else
+                    return SCALAR_KERNEL;
+#endif
+                }
+            } // namespace
+
+            const Kernel &scalarKernel()
+            {
+                return SCALAR_KERNEL;
+            }
+
+            const Kernel &activeKernel()
+            {
+                static const Kernel &kernel = selectKernel();
+                return kernel;
+            }
+
+            size_t availableKernels(std::span<const Kernel *> out)
+            {
+                size_t count = 0;
+                auto add = [&](const Kernel &k)
+                {
+                    if (count < out.size())
+                    {
+                        out[count++] = &k;
+                    }
+                };
+
+                add(SCALAR_KERNEL);
+#ifdef DLT645_CODEC_SSE2
+                add(SSE2_KERNEL);
+#endif
+#ifdef DLT645_CODEC_AVX2
+                if (cpuHasAvx2())
+                {
+                    add(AVX2_KERNEL);
+                }
+#endif
+#ifdef DLT645_CODEC_NEON
+                add(NEON_KERNEL);
+#endif
+                return count;
+            }
+
+            const char *kernelName()
+            {
+                return activeKernel().name;
+            }
+
+            uint8_t encode(std::span<const uint8_t> in, uint8_t *out)
+            {
+                if (in.size() < MIN_VECTOR_LEN)
+                {
+                    return scalarEncode(in.data(), out, in.size());
+                }
+                return activeKernel().encode(in.data(), out, in.size());
+            }
+
+            uint8_t decode(std::span<const uint8_t> in, uint8_t *out)
+            {
+                if (in.size() < MIN_VECTOR_LEN)
+                {
+                    return scalarDecode(in.data(), out, in.size());
+                }
+                return activeKernel().decode(in.data(), out, in.size());
+            }
+
+            uint8_t sum(std::span<const uint8_t> in)
+            {
+                if (in.size() < MIN_VECTOR_LEN)
+                {
+                    return scalarSum(in.data(), in.size());
+                }
+                return activeKernel().sum(in.data(), in.size());
+            }
+
+        } // namespace codec
+    } // namespace protocol
+} // namespace dlt645
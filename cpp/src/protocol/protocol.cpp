@@ -1,4 +1,5 @@
 #include "dlt645/protocol/protocol.h"
+#include "dlt645/protocol/codec.h"
 #include <algorithm>
 #include <stdexcept>
 #include <array>
@@ -12,8 +13,7 @@ namespace dlt645
         std::vector<uint8_t> Frame::decodeData(std::span<const uint8_t> data)
         {
             std::vector<uint8_t> result(data.size());
-            std::ranges::transform(data, result.begin(), [](uint8_t b)
-                                   { return b - 0x33; });
+            codec::decode(data, result.data());
             return result;
         }
 
@@ -21,47 +21,59 @@ namespace dlt645
         std::vector<uint8_t> Frame::encodeData(std::span<const uint8_t> data)
         {
             std::vector<uint8_t> result(data.size());
-            std::ranges::transform(data, result.begin(), [](uint8_t b)
-                                   { return b + 0x33; });
+            codec::encode(data, result.data());
             return result;
         }
 
         // 计算校验和（模256求和）
         uint8_t Frame::calculateChecksum(std::span<const uint8_t> data)
         {
-            uint8_t sum = 0;
-            for (const auto &b : data)
+            return codec::sum(data);
+        }
+
+        // 从第一个68H写到16H，数据域编码与校验和累加在同一遍中完成
+        size_t Frame::encodeBody(uint8_t *out, std::span<const uint8_t, 6> addr, uint8_t ctrlCode, std::span<const uint8_t> data)
+        {
+            uint8_t *p = out;
+            *p++ = FRAME_START_BYTE;
+            p = std::copy(addr.begin(), addr.end(), p);
+            *p++ = FRAME_START_BYTE;
+            *p++ = ctrlCode;
+            *p++ = static_cast<uint8_t>(data.size());
+            uint8_t checkSum = calculateChecksum({out, static_cast<size_t>(p - out)});
+
+            // 数据域编码
+            checkSum += codec::encode(data, p);
+            p += data.size();
+
+            *p++ = checkSum;
+            *p++ = FRAME_END_BYTE;
+            return static_cast<size_t>(p - out);
+        }
+
+        // 将帧写入调用方提供的缓冲区
+        size_t Frame::encode(std::span<uint8_t> out,
+                             std::span<const uint8_t, 6> addr,
+                             uint8_t ctrlCode,
+                             std::span<const uint8_t> data,
+                             size_t preambleLen)
+        {
+            if (data.size() > MAX_DATA_LEN || out.size() < preambleLen + 12 + data.size())
             {
-                sum += b;
+                return 0;
             }
-            return sum;
+
+            // 前导字节
+            std::fill_n(out.begin(), preambleLen, 0xFE);
+            return preambleLen + encodeBody(out.data() + preambleLen, addr, ctrlCode, data);
         }
 
         // 构建帧
         std::vector<uint8_t>
         Frame::buildFrame(std::span<const uint8_t, 6> addr, uint8_t ctrlCode, const std::vector<uint8_t> &data)
         {
-            std::vector<uint8_t> buf;
-            buf.reserve(12 + data.size()); // 预留空间
-
-            buf.push_back(FRAME_START_BYTE);
-            buf.insert(buf.end(), addr.begin(), addr.end());
-            buf.push_back(FRAME_START_BYTE);
-            buf.push_back(ctrlCode);
-
-            // 数据域编码
-            auto encodedData = encodeData(data);
-            buf.push_back(static_cast<uint8_t>(encodedData.size()));
-            buf.insert(buf.end(), encodedData.begin(), encodedData.end());
-
-            // 计算校验和
-            uint8_t checkSum = calculateChecksum(buf);
-            buf.push_back(checkSum);
-            buf.push_back(FRAME_END_BYTE);
-
-            // 前导字节添加
-            std::array<uint8_t, 4> preamble = {0xFE, 0xFE, 0xFE, 0xFE};
-            buf.insert(buf.begin(), preamble.begin(), preamble.end());
+            std::vector<uint8_t> buf(PREAMBLE_LEN + 12 + data.size());
+            buf.resize(encode(buf, addr, ctrlCode, data));
             return buf;
         }
 
@@ -73,103 +85,246 @@ namespace dlt645
                 throw std::runtime_error("Invalid start or end flag");
             }
 
-            std::vector<uint8_t> buf;
-            buf.reserve(preamble.size() + 12 + data.size()); // 预留空间
+            std::vector<uint8_t> buf(preamble.size() + 12 + data.size());
 
             // 写入前导字节
-            buf.insert(buf.end(), preamble.begin(), preamble.end());
-
-            // 写入起始符
-            buf.push_back(startFlag);
-
-            // 写入地址
-            buf.insert(buf.end(), addr.begin(), addr.end());
-
-            // 写入第二个起始符
-            buf.push_back(startFlag);
-
-            // 写入控制码
-            buf.push_back(ctrlCode);
-
-            // 数据域编码
-            auto encodedData = encodeData(data);
-
-            // 写入数据长度
-            buf.push_back(static_cast<uint8_t>(encodedData.size()));
-
-            // 写入编码后的数据
-            buf.insert(buf.end(), encodedData.begin(), encodedData.end());
-
-            // 计算并写入校验和
-            uint8_t checkSum = calculateChecksum(buf);
-            buf.push_back(checkSum);
-
-            // 写入结束符
-            buf.push_back(endFlag);
+            std::ranges::copy(preamble, buf.begin());
 
+            // 写入帧头、编码后的数据、校验和及结束符
+            encodeBody(buf.data() + preamble.size(), addr, ctrlCode, data);
             return buf;
         }
 
         // 反序列化帧
         std::shared_ptr<Frame> Frame::deserialize(const std::vector<uint8_t> &raw)
+        {
+            auto view = FrameView::parse(raw);
+            if (!view)
+            {
+                return nullptr;
+            }
+            return std::make_shared<Frame>(view->toFrame());
+        }
+
+        // 从原始字节解析帧视图
+        std::optional<FrameView> FrameView::parse(std::span<const uint8_t> raw)
         {
             // 基础校验
             if (raw.size() < 12)
-            { // 最小帧长度=起始符(1)+地址(6)+起始符(1)+控制码(1)+数据长度(1)+结束符(1)
-                return nullptr;
+            { // 最小帧长度=起始符(1)+地址(6)+起始符(1)+控制码(1)+数据长度(1)+校验码(1)+结束符(1)
+                return std::nullopt;
             }
 
             // 帧边界检查
             auto startIt = std::ranges::find(raw, FRAME_START_BYTE);
-            if (startIt == raw.end() || std::distance(startIt, raw.end()) < 11)
+            if (startIt == raw.end() || std::distance(startIt, raw.end()) < 12)
             {
-                return nullptr;
+                return std::nullopt;
             }
 
             size_t startIdx = std::distance(raw.begin(), startIt);
-            if (startIdx + 7 >= raw.size() || raw[startIdx + 7] != FRAME_START_BYTE)
+            if (raw[startIdx + 7] != FRAME_START_BYTE)
             { // 第二个起始符位置校验
-                return nullptr;
+                return std::nullopt;
             }
 
-            // 构建帧结构
-            auto frame = std::make_shared<Frame>();
-            frame->startFlag = raw[startIdx];
-            std::copy_n(raw.begin() + startIdx + 1, 6, frame->addr.begin());
-            frame->ctrlCode = raw[startIdx + 8];
-            frame->dataLen = raw[startIdx + 9];
-
-            // 数据域提取
-            size_t dataStart = startIdx + 10;
-            size_t dataEnd = dataStart + frame->dataLen;
-            if (dataEnd > raw.size() - 2)
-            { // 预留校验位和结束符
-                return nullptr;
+            // 数据域边界（预留校验位和结束符）
+            size_t dataEnd = startIdx + 10 + raw[startIdx + 9];
+            if (dataEnd + 2 > raw.size())
+            {
+                return std::nullopt;
             }
 
-            // 数据域解码
-            frame->data = decodeData({raw.begin() + dataStart, frame->dataLen});
-
-            // 校验和验证（从第一个68H到校验码前）
-            std::vector<uint8_t> checkData(raw.begin() + startIdx, raw.begin() + dataEnd);
-            uint8_t calculatedSum = calculateChecksum(checkData);
-
-            if (calculatedSum != raw[dataEnd])
+            // 校验和验证（从第一个68H到校验码前），直接在原缓冲区上计算
+            if (Frame::calculateChecksum(raw.subspan(startIdx, dataEnd - startIdx)) != raw[dataEnd])
             {
-                return nullptr;
+                return std::nullopt;
             }
 
             // 结束符验证
-            if (dataEnd + 1 >= raw.size() || raw[dataEnd + 1] != FRAME_END_BYTE)
+            if (raw[dataEnd + 1] != FRAME_END_BYTE)
             {
-                return nullptr;
+                return std::nullopt;
             }
 
-            frame->checkSum = raw[dataEnd];
-            frame->endFlag = raw[dataEnd + 1];
+            return FrameView(raw.subspan(startIdx, dataEnd + 2 - startIdx));
+        }
+
+        // 将数据域解码到调用方提供的缓冲区
+        size_t FrameView::decodeData(std::span<uint8_t> out) const
+        {
+            auto encoded = encodedData();
+            if (out.size() < encoded.size())
+            {
+                return 0;
+            }
+            codec::decode(encoded, out.data());
+            return encoded.size();
+        }
 
+        // 转换为持有数据的Frame
+        Frame FrameView::toFrame() const
+        {
+            Frame frame;
+            std::ranges::copy(addr(), frame.addr.begin());
+            frame.ctrlCode = ctrlCode();
+            frame.dataLen = dataLen();
+            frame.data = Frame::decodeData(encodedData());
+            frame.checkSum = checkSum();
+            frame.endFlag = raw_.back();
             return frame;
         }
 
+        // 丢弃未完成的帧
+        void FrameDecoder::reset()
+        {
+            state_ = State::Start;
+            pos_ = 0;
+            remaining_ = 0;
+            sum_ = 0;
+        }
+
+        // 流式解码
+        size_t FrameDecoder::decode(std::span<const uint8_t> input, FrameCallback onFrame, void *ctx)
+        {
+            size_t frames = 0;
+            size_t inputPos = 0;
+
+            // 重同步时需要重新扫描的已缓存字节，优先于新输入处理
+            std::array<uint8_t, MAX_FRAME_LEN> replay;
+            size_t replayPos = 0;
+            size_t replayLen = 0;
+
+            while (replayPos < replayLen || inputPos < input.size())
+            {
+                bool fromReplay = replayPos < replayLen;
+                const uint8_t *src = fromReplay ? replay.data() + replayPos : input.data() + inputPos;
+                size_t avail = fromReplay ? replayLen - replayPos : input.size() - inputPos;
+                uint8_t b = src[0];
+                size_t used = 1;
+                bool failed = false;
+                bool complete = false;
+
+                switch (state_)
+                {
+                case State::Start:
+                {
+                    // 跳过前导字节和无效数据，直到帧起始符
+                    const uint8_t *start = std::find(src, src + avail, FRAME_START_BYTE);
+                    used = static_cast<size_t>(start - src);
+                    discarded_ += static_cast<uint64_t>(std::count_if(src, start, [](uint8_t c)
+                                                                       { return c != 0xFE; }));
+                    if (start != src + avail)
+                    {
+                        buf_[0] = FRAME_START_BYTE;
+                        pos_ = 1;
+                        sum_ = FRAME_START_BYTE;
+                        state_ = State::Address;
+                        ++used;
+                    }
+                    break;
+                }
+                case State::Address:
+                    buf_[pos_++] = b;
+                    sum_ += b;
+                    if (pos_ == 7)
+                    {
+                        state_ = State::Start2;
+                    }
+                    break;
+                case State::Start2:
+                    if (b != FRAME_START_BYTE)
+                    {
+                        failed = true;
+                        break;
+                    }
+                    buf_[pos_++] = b;
+                    sum_ += b;
+                    state_ = State::Control;
+                    break;
+                case State::Control:
+                    buf_[pos_++] = b;
+                    sum_ += b;
+                    state_ = State::Length;
+                    break;
+                case State::Length:
+                    buf_[pos_++] = b;
+                    sum_ += b;
+                    remaining_ = b;
+                    state_ = remaining_ > 0 ? State::Data : State::CheckSum;
+                    break;
+                case State::Data:
+                {
+                    // 数据域整段拷贝
+                    used = std::min(avail, remaining_);
+                    std::copy_n(src, used, buf_.begin() + pos_);
+                    sum_ += Frame::calculateChecksum({src, used});
+                    pos_ += used;
+                    remaining_ -= used;
+                    if (remaining_ == 0)
+                    {
+                        state_ = State::CheckSum;
+                    }
+                    break;
+                }
+                case State::CheckSum:
+                    if (b != sum_)
+                    {
+                        failed = true;
+                        break;
+                    }
+                    buf_[pos_++] = b;
+                    state_ = State::End;
+                    break;
+                case State::End:
+                    if (b != FRAME_END_BYTE)
+                    {
+                        failed = true;
+                        break;
+                    }
+                    buf_[pos_++] = b;
+                    complete = true;
+                    break;
+                }
+
+                if (fromReplay)
+                {
+                    replayPos += used;
+                }
+                else
+                {
+                    inputPos += used;
+                }
+
+                if (complete)
+                {
+                    size_t len = pos_;
+                    reset();
+                    ++frames;
+                    onFrame(ctx, FrameView({buf_.data(), len}));
+                }
+                else if (failed)
+                {
+                    // 重同步：候选帧中第一个68H之后可能还有真正的帧头，
+                    // 只回放该位置之后已缓存的字节，不回到流的起点重新扫描
+                    buf_[pos_++] = b;
+                    auto next = std::find(buf_.begin() + 1, buf_.begin() + pos_, FRAME_START_BYTE);
+                    size_t keep = static_cast<size_t>(buf_.begin() + pos_ - next);
+                    discarded_ += pos_ - keep;
+
+                    std::array<uint8_t, MAX_FRAME_LEN> pending;
+                    size_t pendingLen = std::min(keep + (replayLen - replayPos), pending.size());
+                    std::copy_n(next, keep, pending.begin());
+                    std::copy_n(replay.begin() + replayPos, pendingLen - keep, pending.begin() + keep);
+                    std::copy_n(pending.begin(), pendingLen, replay.begin());
+                    replayPos = 0;
+                    replayLen = pendingLen;
+                    reset();
+                }
+            }
+
+            return frames;
+        }
+
     } // namespace protocol
 } // namespace dlt645
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "dlt645/service/client_service.h"
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <cstring>
@@ -16,6 +17,7 @@ namespace dlt645 {
 
         ClientService::ClientService(std::shared_ptr<transport::client::Connection> conn)
             : connection_(std::move(conn))
+            , health_(std::make_shared<DeviceHealth>())
         {
             // 初始化地址和密码为全0
             address_.fill(0);
@@ -31,10 +33,13 @@ namespace dlt645 {
         }
 
         std::shared_ptr<ClientService>
-        ClientService::createTcpClient(const std::string& ip, uint16_t port, std::chrono::milliseconds timeout)
+        ClientService::createTcpClient(const std::string& ip,
+                                       uint16_t port,
+                                       std::chrono::milliseconds timeout,
+                                       std::shared_ptr<transport::IoContextPool> pool)
         {
             // 创建TCP客户端
-            auto tcpClient = std::make_shared<transport::client::TcpClient>();
+            auto tcpClient = std::make_shared<transport::client::TcpClient>(std::move(pool));
             transport::client::TcpClientConfig config;
             config.ip = ip;
             config.port = port;
@@ -54,10 +59,11 @@ namespace dlt645 {
                                                                       int databits,
                                                                       int stopbits,
                                                                       const std::string& parity,
-                                                                      std::chrono::milliseconds timeout)
+                                                                      std::chrono::milliseconds timeout,
+                                                                      std::shared_ptr<transport::IoContextPool> pool)
         {
             // 创建RTU客户端
-            auto rtuClient = std::make_shared<transport::client::RtuClient>();
+            auto rtuClient = std::make_shared<transport::client::RtuClient>(std::move(pool));
             transport::client::RtuClientConfig config;
             config.port = port;
             config.baudRate = baudrate;
@@ -243,13 +249,117 @@ namespace dlt645 {
             }
         }
 
-        bool ClientService::validateDevice(const std::array<uint8_t, 6>& addr) const
+        boost::asio::awaitable<std::vector<uint8_t>> ClientService::asyncSend(std::vector<uint8_t> frame, bool tracked)
+        {
+            // 不是协程本身，直接返回发起操作的awaitable，省去一层协程帧；请求在co_await时才发出
+            return boost::asio::async_initiate<decltype(boost::asio::use_awaitable), void(std::vector<uint8_t>)>(
+                [this, tracked, frame = std::move(frame)](auto handler) {
+                    // 回调在连接的IO线程中执行，结果投递回协程所在的执行器；
+                    // 等待期间执行器记有未完成的工作，io_context不会因为没有其他任务而提前退出
+                    auto executor = boost::asio::prefer(boost::asio::get_associated_executor(handler),
+                                                        boost::asio::execution::outstanding_work.tracked);
+                    auto shared = std::make_shared<decltype(handler)>(std::move(handler));
+                    if (!connection_) {
+                        boost::asio::post(executor, [shared]() { (*shared)(std::vector<uint8_t>()); });
+                        return;
+                    }
+                    auto resume = [shared, executor](std::vector<uint8_t> response) {
+                        boost::asio::post(executor, [shared, response = std::move(response)]() mutable { (*shared)(std::move(response)); });
+                    };
+                    if (tracked) {
+                        sendTracked(frame, std::chrono::milliseconds(0), std::move(resume));
+                    } else {
+                        connection_->sendRequestAsync(frame, std::move(resume));
+                    }
+                },
+                boost::asio::use_awaitable);
+        }
+
+        boost::asio::awaitable<std::shared_ptr<model::DataItem>> ClientService::asyncReadDataItem(uint32_t di)
+        {
+            // 构建数据部分（小端序）
+            std::vector<uint8_t> data(4);
+            data[0] = static_cast<uint8_t>(di & 0xFF);
+            data[1] = static_cast<uint8_t>((di >> 8) & 0xFF);
+            data[2] = static_cast<uint8_t>((di >> 16) & 0xFF);
+            data[3] = static_cast<uint8_t>((di >> 24) & 0xFF);
+
+            // 构建请求帧
+            auto frame = protocol::Frame::buildFrame(address_, model::CTRL_READ_DATA, data);
+
+            // 发送请求并处理响应
+            auto response = co_await asyncSend(std::move(frame));
+            co_return processResponse(response);
+        }
+
+        boost::asio::awaitable<std::shared_ptr<model::DataItem>> ClientService::asyncReadAddress()
+        {
+            // 构建请求帧，读地址命令不需要数据部分
+            auto frame = protocol::Frame::buildFrame(address_, model::READ_ADDRESS, {});
+
+            // 发送请求并处理响应
+            auto response = co_await asyncSend(std::move(frame));
+            co_return processResponse(response);
+        }
+
+        boost::asio::awaitable<std::shared_ptr<model::DataItem>> ClientService::asyncWriteAddress(const std::array<uint8_t, 6>& newAddress)
+        {
+            if (newAddress == address_) {
+                LOG_ERROR("New address is the same as current address");
+                co_return nullptr;
+            }
+
+            // 构建数据部分：包含密码和新地址
+            std::vector<uint8_t> data;
+            data.reserve(4 + 6); // 密码(4字节) + 新地址(6字节)
+            data.insert(data.end(), password_.begin(), password_.end());
+            data.insert(data.end(), newAddress.begin(), newAddress.end());
+
+            // 构建请求帧
+            auto frame = protocol::Frame::buildFrame(address_, model::WRITE_ADDRESS, data);
+
+            // 发送请求并处理响应
+            auto raw = co_await asyncSend(std::move(frame));
+            auto response = processResponse(raw);
+
+            // 如果成功，更新本地地址
+            if (response) {
+                address_ = newAddress;
+            }
+
+            co_return response;
+        }
+
+        boost::asio::awaitable<bool> ClientService::asyncBroadcastTimeSync()
+        {
+            // 构建广播地址
+            uint8_t broadcastAddr[6] = { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA };
+
+            // 构建数据部分（当前时间的BCD码表示）
+            std::array<uint8_t, 5> timeBcd = common::timeToBcd(std::chrono::system_clock::now());
+            std::vector<uint8_t> data(timeBcd.begin(), timeBcd.end());
+
+            // 构建请求帧
+            auto frame = protocol::Frame::buildFrame(broadcastAddr, model::BROADCAST_TIME_SYNC, data);
+
+            if (!connection_ || !connection_->isConnected()) {
+                LOG_ERROR("Not connected");
+                co_return false;
+            }
+
+            // 广播消息不关心响应内容
+            co_await asyncSend(std::move(frame), false);
+            LOG_INFO("Broadcast time sync sent");
+            co_return true;
+        }
+
+        bool ClientService::validateDevice(std::span<const uint8_t, 6> addr) const
         {
             // 检查是否为请求的设备地址或广播地址（99类型）
             std::array<uint8_t, 6> broadcastAddr99 = { 0x99, 0x99, 0x99, 0x99, 0x99, 0x99 };
 
             // 接受设备自身地址或广播地址作为有效响应
-            if (addr == address_ || addr == broadcastAddr99) {
+            if (std::ranges::equal(addr, address_) || std::ranges::equal(addr, broadcastAddr99)) {
                 return true;
             } else {
                 return false;
@@ -273,46 +383,146 @@ namespace dlt645 {
                     return nullptr;
                 }
 
-                // 设置超时
-                connection_->setTimeout(timeout);
-
                 // 发送请求并获取响应
-                auto response = connection_->sendRequest(frame);
-                if (response.empty()) {
-                    LOG_ERROR("Empty response");
-                    return nullptr;
-                }
-                LOG_INFO("Received response: {}", dlt645::common::bytesToHexString(response));
+                auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+                auto future = promise->get_future();
+                sendTracked(frame, timeout, [promise](std::vector<uint8_t> response) { promise->set_value(std::move(response)); });
+                return processResponse(future.get());
+            } catch (const std::exception& e) {
+                LOG_ERROR("Exception during sendAndHandleRequest: %s", e.what());
+                return nullptr;
+            }
+        }
 
-                // 反序列化响应帧
-                auto responseFrame = protocol::Frame::deserialize(response);
-                if (!responseFrame) {
-                    LOG_ERROR("Failed to deserialize response frame");
-                    return nullptr;
+        std::vector<std::shared_ptr<model::DataItem>> ClientService::readMany(std::span<const uint32_t> dis,
+                                                                              std::chrono::milliseconds timeout)
+        {
+            std::vector<std::shared_ptr<model::DataItem>> results(dis.size());
+            try {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                if (!connection_) {
+                    LOG_ERROR("Connection is null");
+                    return results;
                 }
 
-                // 验证设备地址
-                if (!validateDevice(responseFrame->addr)) {
-                    LOG_ERROR("Device address validation failed");
-                    return nullptr;
+                // 确保连接已建立
+                if (!connection_->isConnected() && !connection_->connect()) {
+                    LOG_ERROR("Failed to connect");
+                    return results;
                 }
 
-                // 处理响应
-                return handleResponse(responseFrame);
+                // 先发出全部请求，再按请求顺序取响应；连接按流水线窗口控制同时等待响应的请求数
+                std::vector<std::future<std::vector<uint8_t>>> responses;
+                responses.reserve(dis.size());
+                for (uint32_t di : dis) {
+                    // 构建数据部分（小端序）
+                    std::vector<uint8_t> data(4);
+                    data[0] = static_cast<uint8_t>(di & 0xFF);
+                    data[1] = static_cast<uint8_t>((di >> 8) & 0xFF);
+                    data[2] = static_cast<uint8_t>((di >> 16) & 0xFF);
+                    data[3] = static_cast<uint8_t>((di >> 24) & 0xFF);
+                    auto frame = protocol::Frame::buildFrame(address_, model::CTRL_READ_DATA, data);
+                    auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+                    responses.push_back(promise->get_future());
+                    sendTracked(frame, timeout, [promise](std::vector<uint8_t> response) { promise->set_value(std::move(response)); });
+                }
+                for (size_t i = 0; i < responses.size(); ++i) {
+                    results[i] = processResponse(responses[i].get());
+                }
             } catch (const std::exception& e) {
-                LOG_ERROR("Exception during sendAndHandleRequest: %s", e.what());
-                return nullptr;
+                LOG_ERROR("Exception during readMany: {}", e.what());
+            }
+            return results;
+        }
+
+        void ClientService::sendTracked(const std::vector<uint8_t>& frame,
+                                        std::chrono::milliseconds timeout,
+                                        transport::client::Connection::ResponseHandler handler)
+        {
+            // 链路不可用不是设备的问题，直接失败，不计入设备健康
+            if (!connection_->isConnected()) {
+                LOG_WARN("Connection not available, request skipped");
+                handler({});
+                return;
+            }
+
+            // 熔断中的设备不占用链路时间
+            auto ticket = health_->acquire();
+            if (!ticket) {
+                LOG_WARN("Device circuit open, request skipped");
+                handler({});
+                return;
             }
+
+            if (timeout.count() <= 0) {
+                timeout = health_->timeout();
+            }
+            // 在总线或流水线窗口中排队期间设备可能已熔断（如同一表计的前几个请求已超时），发出前再检查一次，
+            // 不放行的请求不占用链路，也不计入设备健康
+            struct Tracked {
+                DeviceHealth::Ticket ticket;
+                std::chrono::steady_clock::time_point sent = std::chrono::steady_clock::now();
+                bool skipped = false;
+            };
+            auto tracked = std::make_shared<Tracked>(Tracked { *ticket });
+            // 往返时延从连接实际发出请求时算起（与应答超时的起点相同），不含在总线或流水线窗口中排队的时间；
+            // 放行、发出回调先于响应回调调用，三者之间已有先后关系
+            connection_->sendRequestAsync(
+                frame,
+                timeout,
+                [health = health_, tracked]() {
+                    tracked->skipped = !health->admit(tracked->ticket);
+                    return !tracked->skipped;
+                },
+                [tracked](std::chrono::steady_clock::time_point at) { tracked->sent = at; },
+                [health = health_, tracked, handler = std::move(handler)](std::vector<uint8_t> response) {
+                    if (tracked->skipped) {
+                        LOG_WARN("Device circuit opened while queued, request skipped");
+                    } else if (response.empty()) {
+                        health->onFailure(tracked->ticket);
+                    } else {
+                        // RTU的发出时刻按线路速率推算，应答极快时可能略晚于收到响应
+                        health->onSuccess(tracked->ticket,
+                                          std::max(std::chrono::steady_clock::now() - tracked->sent, std::chrono::steady_clock::duration::zero()));
+                    }
+                    handler(std::move(response));
+                });
         }
 
-        std::shared_ptr<model::DataItem> ClientService::handleResponse(const std::shared_ptr<protocol::Frame>& frame)
+        std::shared_ptr<model::DataItem> ClientService::processResponse(const std::vector<uint8_t>& response)
         {
-            if (!frame) {
+            if (response.empty()) {
+                LOG_ERROR("Empty response");
                 return nullptr;
             }
+            LOG_INFO("Received response: {}", dlt645::common::bytesToHexString(response));
+
+            // 解析响应帧（直接引用响应缓冲区，不拷贝）
+            auto responseFrame = protocol::FrameView::parse(response);
+            if (!responseFrame) {
+                LOG_ERROR("Failed to deserialize response frame");
+                return nullptr;
+            }
+
+            // 验证设备地址
+            if (!validateDevice(responseFrame->addr())) {
+                LOG_ERROR("Device address validation failed");
+                return nullptr;
+            }
+
+            // 处理响应
+            return handleResponse(*responseFrame);
+        }
+
+        std::shared_ptr<model::DataItem> ClientService::handleResponse(const protocol::FrameView& frame)
+        {
+            // 数据域解码到栈上缓冲区
+            std::array<uint8_t, protocol::MAX_DATA_LEN> dataBuf;
+            std::span<const uint8_t> data(dataBuf.data(), frame.decodeData(dataBuf));
 
             // 使用switch-case结构处理不同的控制码
-            switch (frame->ctrlCode) {
+            switch (frame.ctrlCode()) {
             case model::BROADCAST_TIME_SYNC | 0x80: {
                 // 广播校时响应
                 LOG_INFO("Broadcast time sync response received");
@@ -325,10 +535,9 @@ namespace dlt645 {
 
             case model::CTRL_READ_DATA | 0x80: {
                 // 读数据响应
-                if (frame->data.size() >= 4) {
+                if (data.size() >= 4) {
                     // 提取数据项标识符（小端序）
-                    uint32_t di = dlt645::common::bytesToIntLittleEndian<uint32_t>(
-                        std::vector<uint8_t>(frame->data.begin(), frame->data.begin() + 4));
+                    uint32_t di = dlt645::common::bytesToIntLittleEndian<uint32_t>(data.first(4));
 
                     // 获取数据类型（DI的第3个字节）
                     uint8_t diType = (di >> 24) & 0xFF;
@@ -345,13 +554,12 @@ namespace dlt645 {
                     case 0x00: {
                         // 00类：电能数据
                         LOG_INFO("Reading energy data response");
-                        if (frame->data.size() >= 8) {
+                        if (data.size() >= 8) {
                             // 解析电能值（4-7字节）
-                            std::vector<uint8_t> valueBytes(frame->data.begin() + 4, frame->data.begin() + 8);
                             float value = 0.0f;
-                            if (!dataItem->dataFormat.empty()) {
+                            if (dataItem->dataFormat != model::DataFormat::Unknown) {
                                 // 使用dataFormat进行解析
-                                value = common::bcdToFloat(valueBytes, dataItem->dataFormat, true);
+                                value = common::bcdToFloat(data.subspan(4, 4), model::bcdFormat(dataItem->dataFormat));
                             }
                             dataItem->value = value;
                             return dataItem;
@@ -361,18 +569,17 @@ namespace dlt645 {
                     case 0x01: {
                         // 01类：最大需量数据
                         LOG_INFO("Reading demand data response");
-                        if (frame->data.size() >= 12) {
+                        if (data.size() >= 12) {
                             // 解析需量值（4-6字节）
-                            std::vector<uint8_t> valueBytes(frame->data.begin() + 4, frame->data.begin() + 7);
                             float demandValue = 0.0f;
 
-                            if (dataItem && !dataItem->dataFormat.empty()) {
+                            if (dataItem && dataItem->dataFormat != model::DataFormat::Unknown) {
                                 // 使用dataFormat进行解析
-                                demandValue = common::bcdToFloat(valueBytes, dataItem->dataFormat, true);
+                                demandValue = common::bcdToFloat(data.subspan(4, 3), model::bcdFormat(dataItem->dataFormat));
                             }
 
                             // 解析发生时间（7-11字节）
-                            std::vector<uint8_t> timeBytes(frame->data.begin() + 7, frame->data.begin() + 12);
+                            std::vector<uint8_t> timeBytes(data.begin() + 7, data.begin() + 12);
                             auto occurTime = common::bcdToTime(timeBytes);
 
                             // 创建需量对象
@@ -385,13 +592,12 @@ namespace dlt645 {
                     case 0x02: {
                         // 02类：变量数据
                         LOG_INFO("Reading variable data response");
-                        if (frame->data.size() >= 6) {
-                            // 解析变量值（4-7字节）
-                            std::vector<uint8_t> valueBytes(frame->data.begin() + 4, frame->data.begin() + 8);
+                        if (data.size() >= 6) {
+                            // 解析变量值（第4字节起）
                             float value = 0.0f;
-                            if (dataItem && !dataItem->dataFormat.empty()) {
+                            if (dataItem && dataItem->dataFormat != model::DataFormat::Unknown) {
                                 // 使用dataFormat进行解析
-                                value = common::bcdToFloat(valueBytes, dataItem->dataFormat, true);
+                                value = common::bcdToFloat(data.subspan(4), model::bcdFormat(dataItem->dataFormat));
                             }
                             dataItem->value = value;
                             return dataItem;
@@ -411,12 +617,12 @@ namespace dlt645 {
             case model::READ_ADDRESS | 0x80: {
                 // 读地址响应
                 LOG_INFO("Read address response received");
-                if (frame->data.size() >= 6) {
+                if (data.size() >= 6) {
                     // 更新本地地址
                     for (int i = 0; i < 6; i++) {
-                        address_[i] = frame->data[i];
+                        address_[i] = data[i];
                     }
-                    std::vector<uint8_t> di(frame->data.begin(), frame->data.begin() + 6);
+                    std::vector<uint8_t> di(data.begin(), data.begin() + 6);
                     std::vector<uint8_t> addressBytes(address_.begin(), address_.end());
                     LOG_INFO("Client address: {}", common::bytesToHexString(addressBytes));
 
@@ -441,7 +647,7 @@ namespace dlt645 {
             }
 
             default: {
-                LOG_WARN("Unknown control code: {}", frame->ctrlCode);
+                LOG_WARN("Unknown control code: {}", frame.ctrlCode());
                 break;
             }
             }
@@ -0,0 +1,147 @@
+#include "dlt645/service/device_health.h"
+#include <algorithm>
+
+namespace dlt645 {
+    namespace service {
+
+        DeviceHealth::DeviceHealth(const DeviceHealthConfig& config)
+            : config_(config)
+        {
+        }
+
+        void DeviceHealth::configure(const DeviceHealthConfig& config)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_ = config;
+        }
+
+        std::optional<DeviceHealth::Ticket> DeviceHealth::acquire(std::chrono::steady_clock::time_point now)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return acquireLocked(now);
+        }
+
+        bool DeviceHealth::admit(Ticket& ticket, std::chrono::steady_clock::time_point now)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (ticket.generation == generation_ && state_ != CircuitState::Open) {
+                return true;
+            }
+            auto renewed = acquireLocked(now);
+            if (!renewed) {
+                return false;
+            }
+            ticket = *renewed;
+            return true;
+        }
+
+        std::optional<DeviceHealth::Ticket> DeviceHealth::acquireLocked(std::chrono::steady_clock::time_point now)
+        {
+            switch (state_) {
+            case CircuitState::Closed:
+                return Ticket { generation_ };
+            case CircuitState::Open:
+                if (now >= openUntil_) {
+                    // 熔断时长已到，本次请求作为探测
+                    state_ = CircuitState::HalfOpen;
+                    return Ticket { ++generation_ };
+                }
+                break;
+            case CircuitState::HalfOpen:
+                // 探测请求尚未结束
+                break;
+            }
+            ++rejected_;
+            return std::nullopt;
+        }
+
+        std::chrono::milliseconds DeviceHealth::timeout() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return timeoutLocked();
+        }
+
+        std::chrono::milliseconds DeviceHealth::timeoutLocked() const
+        {
+            std::chrono::microseconds base = config_.initialTimeout;
+            if (hasSample_) {
+                base = srtt_ + std::max<std::chrono::microseconds>(std::chrono::milliseconds(1), 4 * rttvar_);
+            }
+            auto timeout = std::chrono::ceil<std::chrono::milliseconds>(base * (int64_t(1) << backoffShift_));
+            return std::clamp(timeout, config_.minTimeout, std::max(config_.minTimeout, config_.maxTimeout));
+        }
+
+        void DeviceHealth::onSuccess(const Ticket& ticket, std::chrono::steady_clock::duration rtt)
+        {
+            auto sample = std::chrono::duration_cast<std::chrono::microseconds>(rtt);
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++successes_;
+            if (ticket.generation != generation_) {
+                // 状态切换前放行的请求，只计数
+                return;
+            }
+            if (!hasSample_) {
+                srtt_ = sample;
+                rttvar_ = sample / 2;
+                hasSample_ = true;
+            } else {
+                auto delta = srtt_ > sample ? srtt_ - sample : sample - srtt_;
+                rttvar_ = (rttvar_ * 3 + delta) / 4;
+                srtt_ = (srtt_ * 7 + sample) / 8;
+            }
+            backoffShift_ = 0;
+            consecutiveFailures_ = 0;
+            if (state_ == CircuitState::HalfOpen) {
+                // 探测成功，恢复正常
+                state_ = CircuitState::Closed;
+                opens_ = 0;
+                ++generation_;
+            }
+        }
+
+        void DeviceHealth::onFailure(const Ticket& ticket, std::chrono::steady_clock::time_point now)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++failures_;
+            if (ticket.generation != generation_) {
+                // 熔断前已在途的请求晚到的失败（或探测期间晚到的旧结果），只计数
+                return;
+            }
+            ++consecutiveFailures_;
+            backoffShift_ = std::min(backoffShift_ + 1, MAX_BACKOFF_SHIFT);
+
+            // 连续失败达到阈值或探测失败时熔断
+            if (state_ == CircuitState::HalfOpen || consecutiveFailures_ >= config_.failureThreshold) {
+                open(now);
+            }
+        }
+
+        void DeviceHealth::open(std::chrono::steady_clock::time_point now)
+        {
+            // 熔断时长随连续熔断次数翻倍：首次为openDuration，之后每次探测失败翻倍
+            auto duration = config_.openDuration * (int64_t(1) << std::min(opens_, MAX_BACKOFF_SHIFT));
+            openUntil_ = now + std::min<std::chrono::milliseconds>(duration, config_.maxOpenDuration);
+            state_ = CircuitState::Open;
+            ++opens_;
+            ++generation_;
+        }
+
+        DeviceHealthStats DeviceHealth::stats() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            DeviceHealthStats stats;
+            stats.state = state_;
+            stats.srtt = srtt_;
+            stats.rttvar = rttvar_;
+            stats.timeout = timeoutLocked();
+            stats.consecutiveFailures = consecutiveFailures_;
+            stats.successes = successes_;
+            stats.failures = failures_;
+            stats.rejected = rejected_;
+            stats.opens = opens_;
+            stats.openUntil = openUntil_;
+            return stats;
+        }
+
+    } // namespace service
+} // namespace dlt645
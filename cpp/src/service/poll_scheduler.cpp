@@ -0,0 +1,304 @@
+#include "dlt645/service/poll_scheduler.h"
+#include <algorithm>
+#include <random>
+#include "dlt645/common/log.h"
+
+namespace dlt645 {
+    namespace service {
+
+        class PollScheduler::LinkChannel : public transport::client::Connection {
+        public:
+            explicit LinkChannel(std::shared_ptr<transport::client::Connection> link)
+                : link_(std::move(link))
+            {
+            }
+
+            std::future<bool> connectAsync() override
+            {
+                if (link_->isConnected()) {
+                    std::promise<bool> promise;
+                    promise.set_value(true);
+                    return promise.get_future();
+                }
+                return link_->connectAsync();
+            }
+
+            std::future<void> disconnectAsync() override
+            {
+                // 链路属于调度器，由调用方管理，句柄断开不影响其他表计
+                std::promise<void> promise;
+                promise.set_value();
+                return promise.get_future();
+            }
+
+            using Connection::sendRequestAsync;
+            void sendRequestAsync(const std::vector<uint8_t>& frame, std::chrono::milliseconds timeout, ResponseHandler handler) override
+            {
+                sendRequestAsync(frame, timeout, nullptr, nullptr, std::move(handler));
+            }
+
+            void sendRequestAsync(const std::vector<uint8_t>& frame,
+                                  std::chrono::milliseconds timeout,
+                                  AdmitHandler admit,
+                                  SentHandler onSent,
+                                  ResponseHandler handler) override
+            {
+                if (timeout.count() <= 0) {
+                    timeout = timeout_.load(std::memory_order_relaxed);
+                }
+                link_->sendRequestAsync(frame, timeout, std::move(admit), std::move(onSent), std::move(handler));
+            }
+
+            bool isConnected() const override { return link_->isConnected(); }
+
+            // 只影响本表计的默认应答超时，不修改链路设置
+            void setTimeout(std::chrono::milliseconds timeout) override { timeout_.store(timeout, std::memory_order_relaxed); }
+
+        private:
+            std::shared_ptr<transport::client::Connection> link_;
+            std::atomic<std::chrono::milliseconds> timeout_ { std::chrono::seconds(5) };
+        };
+
+        PollScheduler::PollScheduler(const PollSchedulerConfig& config, BatchHandler handler)
+            : config_(config)
+            , handler_(std::move(handler))
+            , timer_(io_context_)
+        {
+            config_.tick = std::max(config_.tick, std::chrono::milliseconds(1));
+            config_.wheelSize = std::max<size_t>(config_.wheelSize, 1);
+            config_.batchSize = std::max<size_t>(config_.batchSize, 1);
+            wheel_.resize(config_.wheelSize);
+        }
+
+        PollScheduler::~PollScheduler()
+        {
+            stop();
+        }
+
+        size_t PollScheduler::addLink(std::shared_ptr<transport::client::Connection> connection, size_t maxInFlight)
+        {
+            Link link;
+            link.connection = std::move(connection);
+            link.maxInFlight = std::max<size_t>(maxInFlight, 1);
+            links_.push_back(std::move(link));
+            return links_.size() - 1;
+        }
+
+        bool PollScheduler::addMeter(size_t link, const PollTarget& target)
+        {
+            if (running_ || link >= links_.size() || target.dis.empty() || target.interval.count() <= 0) {
+                LOG_ERROR("Invalid poll target");
+                return false;
+            }
+
+            Meter meter;
+            meter.target = target;
+            meter.link = link;
+            meter.intervalTicks = std::max<uint64_t>(target.interval / config_.tick, 1);
+
+            // 每个表计一个ClientService，通过不拥有连接的句柄共享所属链路
+            auto channel = std::make_shared<LinkChannel>(links_[link].connection);
+            channel->setTimeout(config_.timeout);
+            meter.client = std::make_shared<ClientService>(channel);
+            meter.client->setAddress(target.address);
+            DeviceHealthConfig health;
+            health.maxTimeout = config_.timeout;
+            health.initialTimeout = std::min(health.initialTimeout, config_.timeout);
+            meter.client->setHealthConfig(health);
+
+            links_[link].rate += static_cast<double>(target.dis.size()) * 1000.0 / static_cast<double>(target.interval.count());
+            meters_.push_back(std::move(meter));
+            return true;
+        }
+
+        bool PollScheduler::start()
+        {
+            if (running_) {
+                return false;
+            }
+
+            for (auto& link : links_) {
+                if (!link.connection->isConnected() && !link.connection->connect(config_.timeout)) {
+                    LOG_ERROR("Failed to connect poll link");
+                }
+                link.connection->setTimeout(config_.timeout);
+            }
+
+            // 首次轮询时间在一个周期内均匀抖动
+            std::mt19937 rng(config_.seed);
+            currentTick_ = 0;
+            for (auto& slot : wheel_) {
+                slot.clear();
+            }
+            for (size_t i = 0; i < meters_.size(); ++i) {
+                std::uniform_int_distribution<uint64_t> jitter(1, meters_[i].intervalTicks);
+                meters_[i].dueTick = jitter(rng);
+                schedule(i);
+            }
+
+            completed_ = 0;
+            failed_ = 0;
+            skipped_ = 0;
+            stopping_ = false;
+            start_ = std::chrono::steady_clock::now();
+            lastFlush_ = start_;
+            running_ = true;
+
+            timer_.expires_at(start_ + config_.tick);
+            timer_.async_wait([this](const boost::system::error_code& ec) {
+                if (!ec) {
+                    onTick();
+                }
+            });
+
+            io_context_.restart();
+            thread_ = std::thread([this]() { io_context_.run(); });
+            LOG_INFO("Poll scheduler started: {} links, {} meters", links_.size(), meters_.size());
+            return true;
+        }
+
+        void PollScheduler::stop()
+        {
+            if (!running_) {
+                return;
+            }
+
+            // 停止时间轮并等待进行中的读取结束（最长一个应答超时），io_context没有剩余工作后线程退出
+            boost::asio::post(io_context_, [this]() {
+                stopping_ = true;
+                timer_.cancel();
+            });
+            if (thread_.joinable()) {
+                thread_.join();
+            }
+            flush();
+            for (auto& link : links_) {
+                link.ready.clear();
+                link.inFlight = 0;
+            }
+            running_ = false;
+            LOG_INFO("Poll scheduler stopped");
+        }
+
+        PollStats PollScheduler::stats() const
+        {
+            PollStats stats;
+            for (const auto& link : links_) {
+                stats.targetRate += link.rate;
+            }
+            stats.completed = completed_.load(std::memory_order_relaxed);
+            stats.failed = failed_.load(std::memory_order_relaxed);
+            stats.skipped = skipped_.load(std::memory_order_relaxed);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+            if (seconds > 0) {
+                stats.achievedRate = static_cast<double>(stats.completed + stats.failed) / seconds;
+            }
+            return stats;
+        }
+
+        void PollScheduler::schedule(size_t meter)
+        {
+            wheel_[meters_[meter].dueTick % wheel_.size()].push_back(meter);
+        }
+
+        void PollScheduler::onTick()
+        {
+            // 取消定时器时本次到期可能已在排队，停止后不再重新排定
+            if (stopping_) {
+                return;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            uint64_t target = static_cast<uint64_t>((now - start_) / config_.tick);
+
+            // 逐刻度前进（处理期间落后的刻度一并补上），槽内未到期的表计属于之后的轮次，留在槽中
+            while (currentTick_ < target) {
+                ++currentTick_;
+                auto& slot = wheel_[currentTick_ % wheel_.size()];
+                for (size_t i = 0; i < slot.size();) {
+                    size_t meter = slot[i];
+                    if (meters_[meter].dueTick <= currentTick_) {
+                        slot[i] = slot.back();
+                        slot.pop_back();
+                        links_[meters_[meter].link].ready.push_back(meter);
+                        pump(meters_[meter].link);
+                    } else {
+                        ++i;
+                    }
+                }
+            }
+
+            if (!batch_.empty() && now - lastFlush_ >= config_.batchInterval) {
+                flush();
+            }
+
+            timer_.expires_at(start_ + (currentTick_ + 1) * config_.tick);
+            timer_.async_wait([this](const boost::system::error_code& ec) {
+                if (!ec) {
+                    onTick();
+                }
+            });
+        }
+
+        void PollScheduler::pump(size_t link)
+        {
+            auto& state = links_[link];
+            while (!stopping_ && state.inFlight < state.maxInFlight && !state.ready.empty()) {
+                size_t meter = state.ready.front();
+                state.ready.pop_front();
+                ++state.inFlight;
+                boost::asio::co_spawn(io_context_, poll(meter), boost::asio::detached);
+            }
+        }
+
+        boost::asio::awaitable<void> PollScheduler::poll(size_t index)
+        {
+            auto& meter = meters_[index];
+            for (uint32_t di : meter.target.dis) {
+                if (stopping_) {
+                    break;
+                }
+                PollResult result;
+                result.address = meter.target.address;
+                result.di = di;
+                result.item = co_await meter.client->asyncReadDataItem(di);
+                result.time = std::chrono::steady_clock::now();
+                (result.item ? completed_ : failed_).fetch_add(1, std::memory_order_relaxed);
+                batch_.push_back(std::move(result));
+                if (batch_.size() >= config_.batchSize) {
+                    flush();
+                }
+            }
+
+            auto& link = links_[meter.link];
+            --link.inFlight;
+            if (stopping_) {
+                co_return;
+            }
+
+            // 按计划时刻排下一轮；已落后一个周期以上时跳过错过的周期
+            uint64_t next = meter.dueTick + meter.intervalTicks;
+            if (next <= currentTick_) {
+                uint64_t missed = (currentTick_ - next) / meter.intervalTicks + 1;
+                next += missed * meter.intervalTicks;
+                skipped_.fetch_add(missed, std::memory_order_relaxed);
+            }
+            meter.dueTick = next;
+            schedule(index);
+            pump(meter.link);
+        }
+
+        void PollScheduler::flush()
+        {
+            lastFlush_ = std::chrono::steady_clock::now();
+            if (batch_.empty()) {
+                return;
+            }
+            if (handler_) {
+                handler_(batch_);
+            }
+            batch_.clear();
+        }
+
+    } // namespace service
+} // namespace dlt645
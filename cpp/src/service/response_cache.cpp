@@ -0,0 +1,95 @@
+#include "dlt645/service/response_cache.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace dlt645
+{
+    namespace service
+    {
+
+        ResponseCache::ResponseCache(size_t capacity)
+        {
+            capacity = std::bit_ceil(std::max<size_t>(capacity, 1));
+            entries_ = std::make_unique<Entry[]>(capacity);
+            mask_ = capacity - 1;
+        }
+
+        size_t ResponseCache::indexOf(uint64_t address, uintptr_t slot) const
+        {
+            // 槽位地址按32字节对齐，低位无信息；地址参与混合，同一DI的多个表计分散到不同条目
+            uint64_t h = (static_cast<uint64_t>(slot) >> 5) ^ (address * 0x9E3779B97F4A7C15ull);
+            h ^= h >> 29;
+            return static_cast<size_t>(h) & mask_;
+        }
+
+        size_t ResponseCache::lookup(uint64_t address, const void *slot, uint64_t version, std::span<uint8_t> out) const
+        {
+            uintptr_t key = reinterpret_cast<uintptr_t>(slot);
+            const Entry &entry = entries_[indexOf(address, key)];
+
+            uint64_t before = entry.seq.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                return 0; // 写者正在写入，按未命中处理
+            }
+            if (entry.slot.load(std::memory_order_relaxed) != key || entry.address.load(std::memory_order_relaxed) != address
+                || entry.version.load(std::memory_order_relaxed) != version)
+            {
+                return 0;
+            }
+            size_t length = entry.length.load(std::memory_order_relaxed);
+            if (length == 0 || length > MAX_FRAME_LEN || length > out.size())
+            {
+                return 0;
+            }
+
+            std::array<uint64_t, MAX_FRAME_LEN / 8> words;
+            for (size_t i = 0; i < (length + 7) / 8; ++i)
+            {
+                words[i] = entry.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (entry.seq.load(std::memory_order_relaxed) != before)
+            {
+                return 0; // 读取期间被改写
+            }
+
+            std::memcpy(out.data(), words.data(), length);
+            return length;
+        }
+
+        void ResponseCache::store(uint64_t address, const void *slot, uint64_t version, std::span<const uint8_t> frame)
+        {
+            if (frame.empty() || frame.size() > MAX_FRAME_LEN)
+            {
+                return;
+            }
+
+            uintptr_t key = reinterpret_cast<uintptr_t>(slot);
+            Entry &entry = entries_[indexOf(address, key)];
+
+            // 将序号从偶数改为奇数以独占写入，其他线程正在写入时直接放弃
+            uint64_t seq = entry.seq.load(std::memory_order_relaxed);
+            if ((seq & 1) || !entry.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return;
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::array<uint64_t, MAX_FRAME_LEN / 8> words = {};
+            std::memcpy(words.data(), frame.data(), frame.size());
+            for (size_t i = 0; i < (frame.size() + 7) / 8; ++i)
+            {
+                entry.words[i].store(words[i], std::memory_order_relaxed);
+            }
+            entry.slot.store(key, std::memory_order_relaxed);
+            entry.address.store(address, std::memory_order_relaxed);
+            entry.version.store(version, std::memory_order_relaxed);
+            entry.length.store(static_cast<uint32_t>(frame.size()), std::memory_order_relaxed);
+
+            entry.seq.store(seq + 2, std::memory_order_release);
+        }
+
+    } // namespace service
+} // namespace dlt645
@@ -0,0 +1,266 @@
+#include "dlt645/service/rtu_bus.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include "dlt645/common/log.h"
+#include "dlt645/service/virtual_meter.h"
+
+namespace dlt645 {
+    namespace service {
+
+        class RtuBus::Channel : public transport::client::Connection {
+        public:
+            Channel(std::shared_ptr<RtuBus> bus, uint64_t address)
+                : bus_(std::move(bus))
+                , address_(address)
+            {
+            }
+
+            std::future<bool> connectAsync() override
+            {
+                if (bus_->isConnected()) {
+                    std::promise<bool> promise;
+                    promise.set_value(true);
+                    return promise.get_future();
+                }
+                return bus_->port_->connectAsync();
+            }
+
+            std::future<void> disconnectAsync() override
+            {
+                // 串口属于总线，句柄断开不影响其他表计
+                std::promise<void> promise;
+                promise.set_value();
+                return promise.get_future();
+            }
+
+            using Connection::sendRequestAsync;
+            void sendRequestAsync(const std::vector<uint8_t>& frame, std::chrono::milliseconds timeout, ResponseHandler handler) override
+            {
+                sendRequestAsync(frame, timeout, nullptr, nullptr, std::move(handler));
+            }
+
+            void sendRequestAsync(const std::vector<uint8_t>& frame,
+                                  std::chrono::milliseconds timeout,
+                                  AdmitHandler admit,
+                                  SentHandler onSent,
+                                  ResponseHandler handler) override
+            {
+                if (timeout.count() <= 0) {
+                    timeout = timeout_.load(std::memory_order_relaxed);
+                }
+                bus_->submit(address_, Transaction { frame, timeout, std::move(admit), std::move(onSent), std::move(handler) });
+            }
+
+            bool isConnected() const override { return bus_->isConnected(); }
+
+            void setTimeout(std::chrono::milliseconds timeout) override { timeout_.store(timeout, std::memory_order_relaxed); }
+
+        private:
+            std::shared_ptr<RtuBus> bus_;
+            uint64_t address_;
+            std::atomic<std::chrono::milliseconds> timeout_ { std::chrono::seconds(5) };
+        };
+
+        RtuBus::RtuBus(std::shared_ptr<transport::client::Connection> port, const transport::RtuTiming& timing)
+            : port_(std::move(port))
+            , timing_(timing)
+            , statsSince_(std::chrono::steady_clock::now())
+        {
+        }
+
+        RtuBus::~RtuBus()
+        {
+            if (port_ && port_->isConnected()) {
+                port_->disconnect();
+            }
+        }
+
+        std::shared_ptr<RtuBus> RtuBus::createRtuBus(const std::string& port,
+                                                     int baudrate,
+                                                     int databits,
+                                                     int stopbits,
+                                                     const std::string& parity,
+                                                     std::chrono::milliseconds timeout,
+                                                     std::shared_ptr<transport::IoContextPool> pool)
+        {
+            auto rtuClient = std::make_shared<transport::client::RtuClient>(std::move(pool));
+            transport::client::RtuClientConfig config;
+            config.port = port;
+            config.baudRate = baudrate;
+            config.dataBits = databits;
+            config.stopBits = stopbits;
+            config.parity = parity;
+            config.timeout = timeout;
+
+            if (!rtuClient->configure(config)) {
+                LOG_ERROR("Failed to configure RTU client");
+                return nullptr;
+            }
+
+            return std::make_shared<RtuBus>(rtuClient, transport::RtuTiming(baudrate, databits, stopbits, parity));
+        }
+
+        std::shared_ptr<ClientService> RtuBus::client(const std::array<uint8_t, 6>& address)
+        {
+            auto channel = std::make_shared<Channel>(shared_from_this(), packAddress(address));
+            auto client = std::make_shared<ClientService>(channel);
+            client->setAddress(address);
+            return client;
+        }
+
+        bool RtuBus::connect(std::chrono::milliseconds timeout)
+        {
+            return port_->isConnected() || port_->connect(timeout);
+        }
+
+        void RtuBus::disconnect()
+        {
+            port_->disconnect();
+            failPending();
+        }
+
+        RtuBusStats RtuBus::stats() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto now = std::chrono::steady_clock::now();
+            auto busy = busyTime_;
+            if (busy_) {
+                busy += now - std::max(busySince_, statsSince_);
+            }
+
+            RtuBusStats stats;
+            stats.transactions = transactions_;
+            stats.failed = failed_;
+            stats.skipped = skipped_;
+            stats.queued = queued_;
+            stats.busy = std::chrono::duration_cast<std::chrono::microseconds>(busy);
+            stats.wire = std::chrono::duration_cast<std::chrono::microseconds>(timing_.transmitTime(wireChars_));
+            stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - statsSince_);
+            if (stats.elapsed.count() > 0) {
+                stats.utilization = static_cast<double>(stats.busy.count()) / static_cast<double>(stats.elapsed.count());
+                stats.wireUtilization = static_cast<double>(stats.wire.count()) / static_cast<double>(stats.elapsed.count());
+            }
+            return stats;
+        }
+
+        void RtuBus::resetStats()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            transactions_ = 0;
+            failed_ = 0;
+            skipped_ = 0;
+            wireChars_ = 0;
+            busyTime_ = std::chrono::steady_clock::duration::zero();
+            statsSince_ = std::chrono::steady_clock::now();
+        }
+
+        void RtuBus::submit(uint64_t address, Transaction transaction)
+        {
+            if (!port_->isConnected()) {
+                LOG_ERROR("RTU bus not connected");
+                transaction.handler({});
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto& queue = pending_[address];
+                if (queue.empty()) {
+                    rotation_.push_back(address);
+                }
+                queue.push_back(std::move(transaction));
+                ++queued_;
+            }
+            dispatch();
+        }
+
+        void RtuBus::dispatch()
+        {
+            for (;;) {
+                Transaction transaction;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (busy_ || rotation_.empty()) {
+                        return;
+                    }
+
+                    // 取轮转顺序上第一个地址的最早交换，该地址仍有排队时放回队尾
+                    uint64_t address = rotation_.front();
+                    rotation_.pop_front();
+                    auto& queue = pending_[address];
+                    transaction = std::move(queue.front());
+                    queue.pop_front();
+                    if (!queue.empty()) {
+                        rotation_.push_back(address);
+                    }
+                    --queued_;
+                    busy_ = true;
+                    busySince_ = std::chrono::steady_clock::now();
+                }
+
+                // 排队期间表计可能已熔断，不再占用线路，直接结束并取下一个交换
+                if (transaction.admit && !transaction.admit()) {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        busy_ = false;
+                        ++skipped_;
+                    }
+                    transaction.handler({});
+                    continue;
+                }
+
+                // 不持锁调用，端口可能同步回调
+                port_->sendRequestAsync(transaction.frame,
+                                        transaction.timeout,
+                                        nullptr,
+                                        std::move(transaction.onSent),
+                                        [self = shared_from_this(), chars = transaction.frame.size(), handler = std::move(transaction.handler)](
+                                            std::vector<uint8_t> response) mutable { self->complete(chars, std::move(handler), std::move(response)); });
+                return;
+            }
+        }
+
+        void RtuBus::complete(size_t requestChars, transport::client::Connection::ResponseHandler handler, std::vector<uint8_t> response)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                busy_ = false;
+                ++transactions_;
+                wireChars_ += requestChars + response.size();
+                if (response.empty()) {
+                    ++failed_;
+                }
+                busyTime_ += std::chrono::steady_clock::now() - std::max(busySince_, statsSince_);
+            }
+
+            // 先让线路开始下一个交换，再交付本次响应；端口已断开时排队的交换不再发出
+            if (response.empty() && !port_->isConnected()) {
+                failPending();
+            } else {
+                dispatch();
+            }
+            handler(std::move(response));
+        }
+
+        void RtuBus::failPending()
+        {
+            std::vector<Transaction> failed;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto& [address, queue] : pending_) {
+                    for (auto& transaction : queue) {
+                        failed.push_back(std::move(transaction));
+                    }
+                    queue.clear();
+                }
+                rotation_.clear();
+                queued_ = 0;
+            }
+            for (auto& transaction : failed) {
+                transaction.handler({});
+            }
+        }
+
+    } // namespace service
+} // namespace dlt645
@@ -2,6 +2,8 @@
 #include <chrono>
 #include <string>
 #include <array>
+#include <bit>
+#include <cstring>
 #include <span>
 #include <utility>
 #include "dlt645/common/log.h"
@@ -18,26 +20,25 @@ namespace dlt645
                                      std::optional<std::array<uint8_t, 4>> password)
             : server_(std::move(server))
         {
-            // 初始化地址和密码
+            // 初始化地址和密码（未指定时为全0）
             if (address.has_value())
             {
-                address_ = *address;
-            }
-            else
-            {
-                address_.fill(0x00);
+                address_.store(packAddress(*address));
             }
 
             if (password.has_value())
             {
-                password_ = *password;
-            }
-            else
-            {
-                password_.fill(0x00);
+                password_.store(std::bit_cast<uint32_t>(*password));
             }
         }
 
+        std::array<uint8_t, 6> ServerService::getAddress() const { return unpackAddress(address_.load(std::memory_order_relaxed)); }
+
+        std::array<uint8_t, 4> ServerService::getPassword() const
+        {
+            return std::bit_cast<std::array<uint8_t, 4>>(password_.load(std::memory_order_relaxed));
+        }
+
         // 初始化方法，用于在对象完全构造后设置连接处理器
         void ServerService::init()
         {
@@ -49,12 +50,12 @@ namespace dlt645
 
         void ServerService::registerDevice(const std::array<uint8_t, 6> &addr)
         {
-            address_ = addr;
+            address_.store(packAddress(addr), std::memory_order_relaxed);
             LOG_INFO("Device registered with address: {}",
                      common::bytesToHexString(std::vector<uint8_t>(addr.begin(), addr.end())));
         }
 
-        bool ServerService::validateDevice(const std::array<uint8_t, 6> &address) const
+        bool ServerService::validateDevice(std::span<const uint8_t, 6> address) const
         {
             // 处理特殊命令地址
             if (std::ranges::all_of(address, [](uint8_t b)
@@ -68,7 +69,12 @@ namespace dlt645
             {
                 return true; // 广播时间同步命令
             }
-            return address == address_;
+            const uint64_t packed = packAddress(address);
+            if (packed == address_.load(std::memory_order_relaxed))
+            {
+                return true;
+            }
+            return meters_ && meters_->find(packed) != nullptr;
         }
 
         void ServerService::setTime(const std::vector<uint8_t> &dataBytes)
@@ -83,7 +89,7 @@ namespace dlt645
             {
                 throw std::invalid_argument("Invalid address length");
             }
-            address_ = address;
+            address_.store(packAddress(address), std::memory_order_relaxed);
             LOG_INFO("Device address set to: {}", common::bytesToHexString(std::vector<uint8_t>(address.begin(), address.end())));
         }
 
@@ -91,84 +97,179 @@ namespace dlt645
         {
             LOG_INFO("Setting energy value for DI={}: {}", di, value);
 
-            // 获取数据项
-            auto dataItem = DIManager::inst()->getDataItem(di);
+            // 查找数据项（只取元数据引用，不拷贝，读者区间内元数据不会被回收）
+            model::DataItemManager::ReadGuard guard(*DIManager::inst());
+            auto ref = DIManager::inst()->find(di);
 
-            if (!dataItem)
+            if (!ref)
             {
                 LOG_ERROR("Failed to get data item");
                 return false;
             }
 
             // 验证值是否符合数据项的格式
-            if (!model::isValueValid(dataItem->dataFormat, value))
+            if (!model::isValueValid(ref->meta->dataFormat, value))
             {
-                LOG_ERROR("Value {} is out of range for data format {}", value, dataItem->dataFormat);
+                LOG_ERROR("Value {} is out of range for data format {}", value, model::toString(ref->meta->dataFormat));
                 return false;
             }
 
-            // 更新数据项的值
-            dataItem->value = value;
-            dataItem->setTimestamp(std::chrono::system_clock::now());
-
-            // 使用updateDataItem方法更新原始数据
-            return DIManager::inst()->updateDataItem(di, *dataItem);
+            // 只更新值槽位（值、时间戳、版本号）
+            return DIManager::inst()->setValue(di, value);
         }
 
         bool ServerService::set01(uint32_t di, const model::Demand &demand)
         {
             LOG_INFO("Setting demand value for DI={}: {}", di, demand.value);
 
-            // 获取数据项
-            auto dataItem = DIManager::inst()->getDataItem(di);
+            // 查找数据项（只取元数据引用，不拷贝，读者区间内元数据不会被回收）
+            model::DataItemManager::ReadGuard guard(*DIManager::inst());
+            auto ref = DIManager::inst()->find(di);
 
-            if (!dataItem)
+            if (!ref)
             {
                 LOG_ERROR("Failed to get data item");
                 return false;
             }
 
             // 验证值是否符合数据项的格式
-            if (!model::isValueValid(dataItem->dataFormat, demand.value))
+            if (!model::isValueValid(ref->meta->dataFormat, demand.value))
             {
-                LOG_ERROR("Demand value {} is out of range for data format {}", demand.value, dataItem->dataFormat);
+                LOG_ERROR("Demand value {} is out of range for data format {}", demand.value, model::toString(ref->meta->dataFormat));
                 return false;
             }
 
-            // 更新数据项的值
-            dataItem->value = demand;
-            dataItem->setTimestamp(std::chrono::system_clock::now());
-
-            // 使用updateDataItem方法更新原始数据
-            return DIManager::inst()->updateDataItem(di, *dataItem);
+            // 只更新值槽位（值、发生时间、时间戳、版本号）
+            return DIManager::inst()->setDemand(di, demand);
         }
 
         bool ServerService::set02(uint32_t di, float value)
         {
             LOG_INFO("Setting variable value for DI={}: {}", di, value);
 
-            // 获取数据项
-            auto dataItem = DIManager::inst()->getDataItem(di);
+            // 查找数据项（只取元数据引用，不拷贝，读者区间内元数据不会被回收）
+            model::DataItemManager::ReadGuard guard(*DIManager::inst());
+            auto ref = DIManager::inst()->find(di);
 
-            if (!dataItem)
+            if (!ref)
             {
                 LOG_ERROR("Failed to get data item");
                 return false;
             }
 
             // 验证值是否符合数据项的格式
-            if (!model::isValueValid(dataItem->dataFormat, value))
+            if (!model::isValueValid(ref->meta->dataFormat, value))
             {
-                LOG_ERROR("Value {} is out of range for data format {}", value, dataItem->dataFormat);
+                LOG_ERROR("Value {} is out of range for data format {}", value, model::toString(ref->meta->dataFormat));
                 return false;
             }
 
-            // 更新数据项的值
-            dataItem->value = value;
-            dataItem->setTimestamp(std::chrono::system_clock::now());
+            // 只更新值槽位（值、时间戳、版本号）
+            return DIManager::inst()->setValue(di, value);
+        }
 
-            // 使用updateDataItem方法更新原始数据
-            return DIManager::inst()->updateDataItem(di, *dataItem);
+        void ServerService::enableVirtualMeters(size_t maxMeters, size_t valuesPerMeter)
+        {
+            meters_ = std::make_unique<MeterRegistry>(maxMeters, valuesPerMeter);
+            LOG_INFO("Virtual meters enabled: max {} meters, {} bytes per meter", maxMeters, meters_->bytesPerMeter());
+        }
+
+        bool ServerService::addMeter(const std::array<uint8_t, 6> &address)
+        {
+            if (!meters_)
+            {
+                LOG_ERROR("Virtual meters not enabled");
+                return false;
+            }
+            if (!meters_->add(address))
+            {
+                LOG_ERROR("Virtual meter registry is full");
+                return false;
+            }
+            return true;
+        }
+
+        size_t ServerService::meterCount() const { return meters_ ? meters_->size() : 0; }
+
+        model::ValueSlot *ServerService::meterValue(const std::array<uint8_t, 6> &address, uint32_t di, float value)
+        {
+            VirtualMeter *meter = meters_ ? meters_->find(packAddress(address)) : nullptr;
+            if (!meter)
+            {
+                LOG_ERROR("Virtual meter not found: {}", common::bytesToHexString(std::vector<uint8_t>(address.begin(), address.end())));
+                return nullptr;
+            }
+
+            model::DataItemManager::ReadGuard guard(*DIManager::inst());
+            auto ref = DIManager::inst()->find(di);
+            if (!ref)
+            {
+                LOG_ERROR("Failed to get data item");
+                return nullptr;
+            }
+
+            if (!model::isValueValid(ref->meta->dataFormat, value))
+            {
+                LOG_ERROR("Value {} is out of range for data format {}", value, model::toString(ref->meta->dataFormat));
+                return nullptr;
+            }
+
+            model::ValueSlot *slot = meter->findOrInsert(ref->slot);
+            if (!slot)
+            {
+                LOG_ERROR("Value table of virtual meter is full, DI={}", di);
+            }
+            return slot;
+        }
+
+        bool ServerService::set00(const std::array<uint8_t, 6> &address, uint32_t di, float value)
+        {
+            model::ValueSlot *slot = meterValue(address, di, value);
+            if (!slot)
+            {
+                return false;
+            }
+            slot->store(model::LiveValue::Kind::Float, value, {}, std::chrono::system_clock::now());
+            return true;
+        }
+
+        bool ServerService::set01(const std::array<uint8_t, 6> &address, uint32_t di, const model::Demand &demand)
+        {
+            model::ValueSlot *slot = meterValue(address, di, demand.value);
+            if (!slot)
+            {
+                return false;
+            }
+            slot->store(model::LiveValue::Kind::Demand, demand.value, demand.occurTime, std::chrono::system_clock::now());
+            return true;
+        }
+
+        bool ServerService::set02(const std::array<uint8_t, 6> &address, uint32_t di, float value)
+        {
+            model::ValueSlot *slot = meterValue(address, di, value);
+            if (!slot)
+            {
+                return false;
+            }
+            slot->store(model::LiveValue::Kind::Float, value, {}, std::chrono::system_clock::now());
+            return true;
+        }
+
+        const model::ValueSlot &ServerService::valueFor(std::span<const uint8_t, 6> address, const model::DataItemRef &ref) const
+        {
+            if (meters_)
+            {
+                if (const VirtualMeter *meter = meters_->find(packAddress(address)))
+                {
+                    // 槽位已占用但尚未写入第一个值时（版本号为0）仍使用共享值
+                    const model::ValueSlot *own = meter->find(ref.slot);
+                    if (own && own->version() > 0)
+                    {
+                        return *own;
+                    }
+                }
+            }
+            return *ref.value;
         }
 
         void ServerService::setPassword(const std::array<uint8_t, 4> &password)
@@ -177,7 +278,7 @@ namespace dlt645
             {
                 throw std::invalid_argument("Invalid password length");
             }
-            password_ = password;
+            password_.store(std::bit_cast<uint32_t>(password), std::memory_order_relaxed);
 
             std::string passwordStr;
             for (const auto &byte : password)
@@ -203,161 +304,183 @@ namespace dlt645
             // 可以在这里添加连接关闭时的清理逻辑
         }
 
-        std::vector<uint8_t> ServerService::handleRequest(const protocol::Frame &frame)
+        size_t ServerService::handleRequest(const protocol::FrameView &frame, std::span<uint8_t> out)
         {
             // 1. 验证设备
-            if (!validateDevice(frame.addr))
+            if (!validateDevice(frame.addr()))
             {
                 LOG_INFO("Device validation failed for address: {}",
-                         common::bytesToHexString(std::vector<uint8_t>(frame.addr.begin(), frame.addr.end())));
+                         common::bytesToHexString(frame.addr()));
                 throw std::runtime_error("Unauthorized device");
             }
 
+            // 数据域解码到栈上缓冲区，避免堆分配
+            std::array<uint8_t, protocol::MAX_DATA_LEN> dataBuf;
+            std::span<const uint8_t> data(dataBuf.data(), frame.decodeData(dataBuf));
+
             // 2. 根据控制码判断请求类型
-            switch (frame.ctrlCode)
+            switch (frame.ctrlCode())
             {
             case model::BROADCAST_TIME_SYNC:
             {
-                LOG_INFO("Broadcast time sync: {}", common::bytesToHexString(frame.data));
-                setTime(frame.data);
-                return protocol::Frame::buildFrame(frame.addr, frame.ctrlCode | 0x80, frame.data);
+                std::vector<uint8_t> timeData(data.begin(), data.end());
+                LOG_INFO("Broadcast time sync: {}", common::bytesToHexString(timeData));
+                setTime(timeData);
+                return protocol::Frame::encode(out, frame.addr(), frame.ctrlCode() | 0x80, data);
             }
 
             case model::CTRL_READ_DATA:
             {
                 // 解析数据标识
-                if (frame.data.size() < 4)
+                if (data.size() < 4)
                 {
                     LOG_ERROR("Invalid read request data length");
-                    return {};
+                    return 0;
                 }
 
-                uint32_t di = dlt645::common::bytesToIntLittleEndian<uint32_t>(frame.data);
+                uint32_t di = common::bytesToIntLittleEndian<uint32_t>(data);
                 LOG_DEBUG("Read request for DI: {}", di);
 
+                // 值未变化时直接复制上次编码的响应帧；版本号在编码前读取，缓存的帧不会比该版本旧
+                // 编码期间处于读者区间，元数据引用不会被回收
+                model::DataItemManager::ReadGuard guard(*DIManager::inst());
+                const auto ref = DIManager::inst()->find(di);
+                const uint64_t address = packAddress(frame.addr());
+                const model::ValueSlot *slot = ref ? &valueFor(frame.addr(), *ref) : nullptr;
+                const uint64_t version = slot ? slot->version() : 0;
+                if (slot)
+                {
+                    if (size_t cached = responseCache_.lookup(address, slot, version, out))
+                    {
+                        return cached;
+                    }
+                }
+
                 // 检查数据标识的第三个字节
-                uint8_t di3 = frame.data[3];
+                uint8_t di3 = data[3];
 
+                size_t written = 0;
                 switch (di3)
                 {
                 case 0x00:
                     // 读取电能
-                    return handleReadEnergy(frame);
+                    written = handleReadEnergy(frame, data, out);
+                    break;
 
                 case 0x01:
                     // 读取最大需量及发生时间
-                    return handleReadDemand(frame);
+                    written = handleReadDemand(frame, data, out);
+                    break;
 
                 case 0x02:
                     // 读取变量
-                    return handleReadVariable(frame);
+                    written = handleReadVariable(frame, data, out);
+                    break;
 
                 default:
                     LOG_INFO("Unknown data type: {}", fmt::format("{:02X}", di3));
                     throw std::runtime_error("Unknown data type");
                 }
+
+                if (slot && written > 0)
+                {
+                    responseCache_.store(address, slot, version, out.first(written));
+                }
+                return written;
             }
 
             case model::READ_ADDRESS:
             {
                 // 读地址请求
-                std::vector<uint8_t> resData(address_.begin(), address_.end());
-                return protocol::Frame::buildFrame(address_, frame.ctrlCode | 0x80, resData);
+                const std::array<uint8_t, 6> address = getAddress();
+                return protocol::Frame::encode(out, address, frame.ctrlCode() | 0x80, address);
             }
 
             case model::WRITE_ADDRESS:
             {
                 // 写地址请求
-                if (frame.data.size() >= 6)
+                if (data.size() >= 6)
                 {
                     std::array<uint8_t, 6> newAddr;
-                    std::ranges::copy(frame.data.begin(), frame.data.begin() + 6, newAddr.begin());
+                    std::ranges::copy(data.begin(), data.begin() + 6, newAddr.begin());
                     setAddress(newAddr);
                 }
-                return protocol::Frame::buildFrame(address_, frame.ctrlCode | 0x80, {});
+                return protocol::Frame::encode(out, getAddress(), frame.ctrlCode() | 0x80, {});
             }
 
             default:
             {
-                LOG_INFO("Unknown control code: {}", fmt::format("{:02X}", frame.ctrlCode));
+                LOG_INFO("Unknown control code: {}", fmt::format("{:02X}", frame.ctrlCode()));
                 throw std::runtime_error("Unknown control code");
             }
             }
-            return {};
+            return 0;
         }
 
-        std::vector<uint8_t> ServerService::handleReadEnergy(const protocol::Frame &frame)
+        size_t ServerService::handleReadEnergy(const protocol::FrameView &frame, std::span<const uint8_t> data, std::span<uint8_t> out)
         {
             // 解析数据标识为32位无符号整数
-            uint32_t dataId = dlt645::common::bytesToIntLittleEndian<uint32_t>(frame.data);
+            uint32_t dataId = common::bytesToIntLittleEndian<uint32_t>(data);
 
-            // 获取数据项
-            const auto dataItem = DIManager::inst()->getDataItem(dataId);
-            if (!dataItem)
+            // 查找数据项（元数据引用，不拷贝）
+            const auto ref = DIManager::inst()->find(dataId);
+            if (!ref)
             {
                 LOG_ERROR("Data item not found for ID: {}", dataId);
-                return {};
+                return 0;
             }
+            const model::LiveValue live = valueFor(frame.addr(), *ref).load();
 
             // 构建响应数据
-            std::vector<uint8_t> resData(8);
+            std::array<uint8_t, 8> resData = { 0 };
             // 复制前4字节数据标识
-            std::ranges::copy(frame.data.begin(), frame.data.begin() + 4, resData.begin());
+            std::ranges::copy(data.begin(), data.begin() + 4, resData.begin());
 
-            if (std::holds_alternative<float>(dataItem->value))
+            if (live.kind == model::LiveValue::Kind::Float)
             {
-                float value = std::get<float>(dataItem->value);
-                // 将浮点数转换为BCD码
-                auto bcdValue = dlt645::common::floatToBcd(value, dataItem->dataFormat, true);
-                // 复制BCD值到响应数据
-                if (bcdValue.size() >= 4)
+                // 将浮点数按格式转换为BCD码，直接写入响应数据；超出格式范围时不能应答错误的数值
+                if (common::floatToBcd(live.value, model::bcdFormat(ref->meta->dataFormat), std::span<uint8_t>(resData).subspan(4)) == 0)
                 {
-                    std::ranges::copy(bcdValue.begin(), bcdValue.begin() + 4, resData.begin() + 4);
+                    LOG_ERROR("Value {} is out of range for data format {}, DI={:08X}", live.value, model::toString(ref->meta->dataFormat), dataId);
+                    return encodeError(frame, model::ERR_OTHER, out);
                 }
             }
 
             // 构建响应帧
-            return protocol::Frame::buildFrame(frame.addr, frame.ctrlCode | 0x80, resData);
+            return protocol::Frame::encode(out, frame.addr(), frame.ctrlCode() | 0x80, resData);
         }
 
-        std::vector<uint8_t> ServerService::handleReadDemand(const protocol::Frame &frame)
+        size_t ServerService::handleReadDemand(const protocol::FrameView &frame, std::span<const uint8_t> data, std::span<uint8_t> out)
         {
             // 解析数据标识为32位无符号整数
-            uint32_t dataId = common::bytesToIntLittleEndian<uint32_t>(frame.data);
+            uint32_t dataId = common::bytesToIntLittleEndian<uint32_t>(data);
 
-            // 获取数据项
-            const auto dataItem = DIManager::inst()->getDataItem(dataId);
-            if (!dataItem)
+            // 查找数据项（元数据引用，不拷贝）
+            const auto ref = DIManager::inst()->find(dataId);
+            if (!ref)
             {
                 LOG_ERROR("Data item not found for ID: {}", dataId);
-                return {};
+                return 0;
             }
+            const model::LiveValue live = valueFor(frame.addr(), *ref).load();
 
             // 构建响应数据
-            std::vector<uint8_t> resData(12);
+            std::array<uint8_t, 12> resData = { 0 };
             // 复制前4字节数据标识
-            std::ranges::copy(frame.data.begin(), frame.data.begin() + 4, resData.begin());
+            std::ranges::copy(data.begin(), data.begin() + 4, resData.begin());
 
             // 处理数据值
-            if (std::holds_alternative<model::Demand>(dataItem->value))
+            if (live.kind == model::LiveValue::Kind::Demand)
             {
-                const model::Demand &demand = std::get<model::Demand>(dataItem->value);
-                // 将需量值转换为BCD码
-                auto bcdValue = dlt645::common::floatToBcd(demand.value, dataItem->dataFormat, true);
-                // 确保BCD值至少有3个字节
-                if (bcdValue.size() < 3)
-                {
-                    bcdValue.resize(3, 0);
-                }
-                // 复制BCD值到响应数据
-                if (bcdValue.size() >= 3)
+                // 将需量值按格式转换为BCD码（3字节），直接写入响应数据；超出格式范围时不能应答错误的数值
+                if (common::floatToBcd(live.value, model::bcdFormat(ref->meta->dataFormat), std::span<uint8_t>(resData).subspan(4, 3)) == 0)
                 {
-                    std::ranges::copy(bcdValue.begin(), bcdValue.begin() + 3, resData.begin() + 4);
+                    LOG_ERROR("Demand value {} is out of range for data format {}, DI={:08X}", live.value, model::toString(ref->meta->dataFormat), dataId);
+                    return encodeError(frame, model::ERR_OTHER, out);
                 }
 
-                // 获取当前时间并转换为BCD码
-                auto now = std::chrono::system_clock::now();
-                auto timeBcd = dlt645::common::timeToBcd(now, true);
+                // 发生时间转换为BCD码（set01写入的需量发生时间）
+                auto timeBcd = dlt645::common::timeToBcd(live.occurTime, true);
                 // 复制时间BCD码到响应数据
                 if (timeBcd.size() >= 5)
                 {
@@ -368,48 +491,50 @@ namespace dlt645
             LOG_INFO("Reading maximum demand and occurrence time: {}", common::bytesToHexString(resData));
 
             // 构建响应帧
-            return protocol::Frame::buildFrame(frame.addr, frame.ctrlCode | 0x80, resData);
+            return protocol::Frame::encode(out, frame.addr(), frame.ctrlCode() | 0x80, resData);
         }
 
-        std::vector<uint8_t> ServerService::handleReadVariable(const protocol::Frame &frame)
+        size_t ServerService::handleReadVariable(const protocol::FrameView &frame, std::span<const uint8_t> data, std::span<uint8_t> out)
         {
             // 解析数据标识为32位无符号整数
-            uint32_t dataId = dlt645::common::bytesToIntLittleEndian<uint32_t>(frame.data);
+            uint32_t dataId = common::bytesToIntLittleEndian<uint32_t>(data);
 
-            // 获取数据项
-            const auto dataItem = DIManager::inst()->getDataItem(dataId);
-            if (!dataItem)
+            // 查找数据项（元数据引用，不拷贝）
+            const auto ref = DIManager::inst()->find(dataId);
+            if (!ref)
             {
                 LOG_ERROR("Data item not found for ID: {}", dataId);
-                return {};
+                return 0;
             }
+            const model::LiveValue live = valueFor(frame.addr(), *ref).load();
 
-            // 计算变量数据长度
-            size_t dataLen = 4; // 数据标识长度
-            // 根据数据格式计算额外长度
-            if (!dataItem->dataFormat.empty())
-            {
-                dataLen += (dataItem->dataFormat.length() - 1) / 2; // (数据格式长度 - 1位小数点)/2
-            }
+            // 计算变量数据长度：数据标识(4字节) + 格式对应的BCD字节数
+            const common::BcdFormat &format = model::bcdFormat(ref->meta->dataFormat);
+            size_t dataLen = 4 + format.byteWidth;
 
             // 构建响应数据
-            std::vector<uint8_t> resData(dataLen);
+            std::array<uint8_t, 4 + (common::BcdFormat::MAX_DIGITS + 1) / 2> resData = { 0 };
             // 复制前4字节数据标识
-            std::ranges::copy(frame.data.begin(), frame.data.begin() + 4, resData.begin());
+            std::ranges::copy(data.begin(), data.begin() + 4, resData.begin());
 
             // 处理数据值
-            if (std::holds_alternative<float>(dataItem->value))
+            if (live.kind == model::LiveValue::Kind::Float)
             {
-                float value = std::get<float>(dataItem->value);
-                // 将浮点数转换为BCD码（小端序）
-                auto bcdValue = dlt645::common::floatToBcd(value, dataItem->dataFormat, true);
-                // 复制BCD值到响应数据
-                size_t bcdCopyLen = std::min(bcdValue.size(), dataLen - 4);
-                std::ranges::copy(bcdValue.begin(), bcdValue.begin() + bcdCopyLen, resData.begin() + 4);
+                // 将浮点数转换为BCD码（小端序），直接写入响应数据；超出格式范围时不能应答错误的数值
+                if (common::floatToBcd(live.value, format, std::span<uint8_t>(resData).subspan(4)) == 0)
+                {
+                    LOG_ERROR("Value {} is out of range for data format {}, DI={:08X}", live.value, model::toString(ref->meta->dataFormat), dataId);
+                    return encodeError(frame, model::ERR_OTHER, out);
+                }
             }
 
             // 构建响应帧
-            return protocol::Frame::buildFrame(frame.addr, frame.ctrlCode | 0x80, resData);
+            return protocol::Frame::encode(out, frame.addr(), frame.ctrlCode() | 0x80, std::span<const uint8_t>(resData).first(dataLen));
+        }
+
+        size_t ServerService::encodeError(const protocol::FrameView &frame, uint8_t error, std::span<uint8_t> out) const
+        {
+            return protocol::Frame::encode(out, frame.addr(), frame.ctrlCode() | 0x80 | model::CTRL_ABNORMAL, std::span<const uint8_t>(&error, 1));
         }
 
         bool ServerService::start()
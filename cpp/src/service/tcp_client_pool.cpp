@@ -0,0 +1,383 @@
+#include "dlt645/service/tcp_client_pool.h"
+#include <algorithm>
+#include "dlt645/common/log.h"
+#include "dlt645/model/model.h"
+#include "dlt645/protocol/protocol.h"
+
+namespace dlt645 {
+    namespace service {
+
+        struct TcpClientPool::Member {
+            enum class State {
+                Down,       // 未连接，等待重连时刻
+                Connecting, // 连接中
+                Ready,      // 已连接
+                Closing,    // 关闭中，关闭完成后重连
+            };
+
+            std::atomic<bool> ready { false };   // 可分配请求（后台线程置位，探测失败时在IO线程清除）
+            std::atomic<size_t> inFlight { 0 }; // 等待响应的请求数
+            std::atomic<std::chrono::steady_clock::rep> lastActive { 0 }; // 最后收到响应的时刻
+            std::atomic<bool> probing { false };
+
+            // 以下只在后台线程访问
+            State state = State::Down;
+            bool connectedOnce = false;
+            std::future<bool> connecting;
+            std::future<void> closing;
+            std::chrono::steady_clock::time_point retryAt;
+            std::chrono::milliseconds backoff { 0 };
+
+            // 当前连接：每次连接都创建新的TcpClient（重用会在请求线程使用socket时替换它），由后台线程替换，
+            // 请求线程原子地取出后使用，被替换的连接由仍在使用它的请求线程持有到调用结束；
+            // 放在最后，先于上面的状态析构（析构时结束的请求回调仍会访问状态）
+            std::atomic<std::shared_ptr<transport::client::TcpClient>> client;
+        };
+
+        class TcpClientPool::Channel : public transport::client::Connection {
+        public:
+            explicit Channel(std::shared_ptr<TcpClientPool> pool)
+                : pool_(std::move(pool))
+                , timeout_(pool_->config_.client.timeout)
+            {
+            }
+
+            std::future<bool> connectAsync() override
+            {
+                // 连接由连接池在后台建立，这里不等待
+                std::promise<bool> promise;
+                promise.set_value(pool_->isConnected());
+                return promise.get_future();
+            }
+
+            std::future<void> disconnectAsync() override
+            {
+                // 连接属于连接池，句柄断开不影响其他句柄
+                std::promise<void> promise;
+                promise.set_value();
+                return promise.get_future();
+            }
+
+            using Connection::sendRequestAsync;
+            void sendRequestAsync(const std::vector<uint8_t>& frame, std::chrono::milliseconds timeout, ResponseHandler handler) override
+            {
+                sendRequestAsync(frame, timeout, nullptr, nullptr, std::move(handler));
+            }
+
+            void sendRequestAsync(const std::vector<uint8_t>& frame,
+                                  std::chrono::milliseconds timeout,
+                                  AdmitHandler admit,
+                                  SentHandler onSent,
+                                  ResponseHandler handler) override
+            {
+                if (timeout.count() <= 0) {
+                    timeout = timeout_.load(std::memory_order_relaxed);
+                }
+                pool_->send(frame, timeout, std::move(admit), std::move(onSent), std::move(handler));
+            }
+
+            bool isConnected() const override { return pool_->isConnected(); }
+
+            void setTimeout(std::chrono::milliseconds timeout) override { timeout_.store(timeout, std::memory_order_relaxed); }
+
+        private:
+            std::shared_ptr<TcpClientPool> pool_;
+            std::atomic<std::chrono::milliseconds> timeout_;
+        };
+
+        TcpClientPool::TcpClientPool(const TcpClientPoolConfig& config, std::shared_ptr<transport::IoContextPool> pool)
+            : config_(config)
+            , pool_(std::move(pool))
+            , timer_(io_context_)
+        {
+            config_.size = std::max<size_t>(config_.size, 1);
+            config_.checkInterval = std::max(config_.checkInterval, std::chrono::milliseconds(1));
+            config_.maxReconnectDelay = std::max(config_.maxReconnectDelay, config_.reconnectDelay);
+
+            for (size_t i = 0; i < config_.size; ++i) {
+                auto member = std::make_unique<Member>();
+                member->backoff = config_.reconnectDelay;
+                members_.push_back(std::move(member));
+            }
+
+            // 探测帧：读通讯地址
+            probeFrame_ = protocol::Frame::buildFrame(config_.probeAddress, model::READ_ADDRESS, {});
+        }
+
+        TcpClientPool::~TcpClientPool()
+        {
+            stop();
+        }
+
+        std::shared_ptr<TcpClientPool> TcpClientPool::createTcpClientPool(const std::string& ip,
+                                                                          uint16_t port,
+                                                                          size_t size,
+                                                                          std::chrono::milliseconds timeout,
+                                                                          std::shared_ptr<transport::IoContextPool> pool)
+        {
+            TcpClientPoolConfig config;
+            config.client.ip = ip;
+            config.client.port = port;
+            config.client.timeout = timeout;
+            config.size = size;
+            LOG_INFO("Creating TCP client pool with IP: {}, port: {}, size: {}", ip, port, size);
+            return std::make_shared<TcpClientPool>(config, std::move(pool));
+        }
+
+        bool TcpClientPool::start()
+        {
+            if (running_) {
+                return false;
+            }
+
+            // 所有连接同时发出，等待时间不超过一个连接超时
+            for (auto& member : members_) {
+                beginConnect(*member);
+            }
+            auto now = std::chrono::steady_clock::now();
+            for (auto& member : members_) {
+                member->connecting.wait();
+                finishConnect(*member, member->connecting.get(), now);
+            }
+
+            stopping_ = false;
+            running_ = true;
+            scheduleCheck();
+            io_context_.restart();
+            thread_ = std::thread([this]() { io_context_.run(); });
+
+            size_t warm = warm_.load(std::memory_order_relaxed);
+            LOG_INFO("TCP client pool started: {}/{} connections to {}:{}", warm, members_.size(), config_.client.ip, config_.client.port);
+            return warm > 0;
+        }
+
+        void TcpClientPool::stop()
+        {
+            if (!running_) {
+                return;
+            }
+
+            boost::asio::post(io_context_, [this]() {
+                stopping_ = true;
+                timer_.cancel();
+            });
+            if (thread_.joinable()) {
+                thread_.join();
+            }
+
+            // 等进行中的连接和关闭操作结束，再关闭已建立的连接（未完成的请求以失败结束）
+            for (auto& member : members_) {
+                member->ready = false;
+                if (member->state == Member::State::Connecting) {
+                    member->connecting.wait();
+                } else if (member->state == Member::State::Closing) {
+                    member->closing.wait();
+                }
+                auto client = member->client.load();
+                if (client && client->isConnected()) {
+                    client->disconnect();
+                }
+                member->state = Member::State::Down;
+                member->backoff = config_.reconnectDelay;
+            }
+            warm_ = 0;
+            running_ = false;
+            LOG_INFO("TCP client pool stopped");
+        }
+
+        std::shared_ptr<transport::client::Connection> TcpClientPool::connection()
+        {
+            return std::make_shared<Channel>(shared_from_this());
+        }
+
+        std::shared_ptr<ClientService> TcpClientPool::client(const std::array<uint8_t, 6>& address)
+        {
+            auto client = std::make_shared<ClientService>(connection());
+            client->setAddress(address);
+            return client;
+        }
+
+        TcpClientPoolStats TcpClientPool::stats() const
+        {
+            TcpClientPoolStats stats;
+            stats.size = members_.size();
+            stats.warm = warm_.load(std::memory_order_relaxed);
+            stats.requests = requests_.load(std::memory_order_relaxed);
+            stats.rejected = rejected_.load(std::memory_order_relaxed);
+            stats.reconnects = reconnects_.load(std::memory_order_relaxed);
+            stats.connectFailures = connectFailures_.load(std::memory_order_relaxed);
+            stats.probeFailures = probeFailures_.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        void TcpClientPool::send(const std::vector<uint8_t>& frame,
+                                 std::chrono::milliseconds timeout,
+                                 transport::client::Connection::AdmitHandler admit,
+                                 transport::client::Connection::SentHandler onSent,
+                                 transport::client::Connection::ResponseHandler handler)
+        {
+            // 从轮转位置开始找等待响应的请求最少的可用连接
+            Member* best = nullptr;
+            size_t bestLoad = 0;
+            size_t start = next_.fetch_add(1, std::memory_order_relaxed);
+            std::shared_ptr<transport::client::TcpClient> client;
+            for (size_t i = 0; i < members_.size(); ++i) {
+                auto& member = *members_[(start + i) % members_.size()];
+                if (!member.ready.load(std::memory_order_acquire)) {
+                    continue;
+                }
+                size_t load = member.inFlight.load(std::memory_order_relaxed);
+                if (best && load >= bestLoad) {
+                    continue;
+                }
+                auto candidate = member.client.load();
+                if (!candidate || !candidate->isConnected()) {
+                    continue;
+                }
+                best = &member;
+                bestLoad = load;
+                client = std::move(candidate);
+                if (load == 0) {
+                    break;
+                }
+            }
+
+            if (!best) {
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                LOG_WARN("No connection available in TCP client pool");
+                handler({});
+                return;
+            }
+
+            requests_.fetch_add(1, std::memory_order_relaxed);
+            best->inFlight.fetch_add(1, std::memory_order_relaxed);
+            client->sendRequestAsync(frame,
+                                           timeout,
+                                           std::move(admit),
+                                           std::move(onSent),
+                                           [self = shared_from_this(), member = best, handler = std::move(handler)](std::vector<uint8_t> response) {
+                                               if (!response.empty()) {
+                                                   member->lastActive.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                                                            std::memory_order_relaxed);
+                                               }
+                                               member->inFlight.fetch_sub(1, std::memory_order_relaxed);
+                                               handler(std::move(response));
+                                           });
+        }
+
+        void TcpClientPool::scheduleCheck()
+        {
+            timer_.expires_after(config_.checkInterval);
+            timer_.async_wait([this](const boost::system::error_code& ec) {
+                if (!ec) {
+                    onCheck();
+                }
+            });
+        }
+
+        void TcpClientPool::onCheck()
+        {
+            // 取消定时器时本次检查可能已在排队，停止后不再重新排定
+            if (stopping_) {
+                return;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            auto ready = [](const auto& future) { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; };
+            for (auto& pointer : members_) {
+                auto& member = *pointer;
+                switch (member.state) {
+                case Member::State::Connecting:
+                    if (ready(member.connecting)) {
+                        finishConnect(member, member.connecting.get(), now);
+                    }
+                    break;
+                case Member::State::Ready:
+                    if (!member.ready || !member.client.load()->isConnected()) {
+                        // 对端关闭、收发出错或探测无应答：不再分配请求，关闭后立即重连
+                        warm_.fetch_sub(1, std::memory_order_relaxed);
+                        beginClose(member);
+                    } else if (config_.idleTimeout.count() > 0 && !member.probing) {
+                        // 空闲或请求一直没有响应（对端掉电、网络中断时连接不会断开）都要探测
+                        auto lastActive = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(member.lastActive.load()));
+                        if (now - lastActive >= config_.idleTimeout) {
+                            probe(member);
+                        }
+                    }
+                    break;
+                case Member::State::Closing:
+                    if (ready(member.closing)) {
+                        member.closing.get();
+                        beginConnect(member);
+                    }
+                    break;
+                case Member::State::Down:
+                    if (now >= member.retryAt) {
+                        beginConnect(member);
+                    }
+                    break;
+                }
+            }
+
+            scheduleCheck();
+        }
+
+        void TcpClientPool::beginConnect(Member& member)
+        {
+            // 旧连接已关闭或从未建立，此时成员不可分配请求；请求线程可能刚取出旧连接，旧连接对其直接失败
+            auto client = std::make_shared<transport::client::TcpClient>(pool_);
+            client->configure(config_.client);
+            member.client.store(client);
+            member.state = Member::State::Connecting;
+            member.connecting = client->connectAsync();
+        }
+
+        void TcpClientPool::finishConnect(Member& member, bool connected, std::chrono::steady_clock::time_point now)
+        {
+            if (!connected) {
+                // 按退避时间重连，每次失败翻倍
+                connectFailures_.fetch_add(1, std::memory_order_relaxed);
+                member.state = Member::State::Down;
+                member.retryAt = now + member.backoff;
+                LOG_WARN("TCP client pool connection failed, retry in {} ms", member.backoff.count());
+                member.backoff = std::min(member.backoff * 2, config_.maxReconnectDelay);
+                return;
+            }
+
+            if (member.connectedOnce) {
+                reconnects_.fetch_add(1, std::memory_order_relaxed);
+            }
+            member.connectedOnce = true;
+            member.backoff = config_.reconnectDelay;
+            member.lastActive.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+            member.state = Member::State::Ready;
+            member.ready.store(true, std::memory_order_release);
+            warm_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void TcpClientPool::beginClose(Member& member)
+        {
+            member.ready = false;
+            member.state = Member::State::Closing;
+            member.closing = member.client.load()->disconnectAsync();
+        }
+
+        void TcpClientPool::probe(Member& member)
+        {
+            member.probing = true;
+            member.client.load()->sendRequestAsync(probeFrame_, config_.probeTimeout, [this, &member](std::vector<uint8_t> response) {
+                if (response.empty()) {
+                    // 只在连接仍被认为可用时计数，关闭连接导致的失败不算
+                    if (member.ready.exchange(false)) {
+                        probeFailures_.fetch_add(1, std::memory_order_relaxed);
+                        LOG_WARN("TCP client pool probe timed out, reconnecting");
+                    }
+                } else {
+                    member.lastActive.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+                }
+                member.probing = false;
+            });
+        }
+
+    } // namespace service
+} // namespace dlt645
@@ -0,0 +1,146 @@
+#include "dlt645/service/virtual_meter.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace dlt645
+{
+    namespace service
+    {
+
+        uint64_t packAddress(std::span<const uint8_t, 6> address)
+        {
+            uint64_t packed = 0;
+            std::memcpy(&packed, address.data(), address.size());
+            return packed;
+        }
+
+        std::array<uint8_t, 6> unpackAddress(uint64_t packed)
+        {
+            std::array<uint8_t, 6> address;
+            std::memcpy(address.data(), &packed, address.size());
+            return address;
+        }
+
+        VirtualMeter::VirtualMeter(uint64_t address, size_t capacity)
+            : address_(address), mask_(std::bit_ceil(std::max<size_t>(capacity, 1)) - 1), entries_(std::make_unique<Entry[]>(mask_ + 1))
+        {
+        }
+
+        const model::ValueSlot *VirtualMeter::find(uint32_t slot) const
+        {
+            size_t pos = indexOf(slot);
+            for (size_t probe = 0; probe <= mask_; ++probe)
+            {
+                const Entry &entry = entries_[pos];
+                uint32_t key = entry.slot.load(std::memory_order_acquire);
+                if (key == slot)
+                {
+                    return &entry.value;
+                }
+                if (key == EMPTY)
+                {
+                    return nullptr;
+                }
+                pos = (pos + 1) & mask_;
+            }
+            return nullptr;
+        }
+
+        model::ValueSlot *VirtualMeter::findOrInsert(uint32_t slot)
+        {
+            size_t pos = indexOf(slot);
+            for (size_t probe = 0; probe <= mask_; ++probe)
+            {
+                Entry &entry = entries_[pos];
+                uint32_t key = entry.slot.load(std::memory_order_acquire);
+                if (key == EMPTY)
+                {
+                    // 占用空桶；失败说明被其他写者抢先，按其写入的槽位号继续判断
+                    if (entry.slot.compare_exchange_strong(key, slot, std::memory_order_acq_rel))
+                    {
+                        return &entry.value;
+                    }
+                }
+                if (key == slot)
+                {
+                    return &entry.value;
+                }
+                pos = (pos + 1) & mask_;
+            }
+            return nullptr;
+        }
+
+        MeterRegistry::MeterRegistry(size_t maxMeters, size_t valuesPerMeter)
+            : maxMeters_(maxMeters), valuesPerMeter_(valuesPerMeter)
+        {
+            // 负载因子不超过1/2
+            size_t capacity = std::bit_ceil(std::max<size_t>(maxMeters * 2, 2));
+            mask_ = capacity - 1;
+            buckets_ = std::make_unique<std::atomic<VirtualMeter *>[]>(capacity);
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                buckets_[i].store(nullptr, std::memory_order_relaxed);
+            }
+            meters_.reserve(maxMeters);
+        }
+
+        size_t MeterRegistry::indexOf(uint64_t address) const
+        {
+            uint64_t h = address * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(h >> 32) & mask_;
+        }
+
+        VirtualMeter *MeterRegistry::add(const std::array<uint8_t, 6> &address)
+        {
+            uint64_t key = packAddress(address);
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            size_t pos = indexOf(key);
+            while (VirtualMeter *meter = buckets_[pos].load(std::memory_order_relaxed))
+            {
+                if (meter->address() == key)
+                {
+                    return meter;
+                }
+                pos = (pos + 1) & mask_;
+            }
+            if (meters_.size() >= maxMeters_)
+            {
+                return nullptr;
+            }
+
+            // 表计构造完成后再发布到桶中，读者看到指针时表计已完整
+            meters_.push_back(std::make_unique<VirtualMeter>(key, valuesPerMeter_));
+            buckets_[pos].store(meters_.back().get(), std::memory_order_release);
+            count_.store(meters_.size(), std::memory_order_release);
+            return meters_.back().get();
+        }
+
+        VirtualMeter *MeterRegistry::find(uint64_t address) const
+        {
+            size_t pos = indexOf(address);
+            while (VirtualMeter *meter = buckets_[pos].load(std::memory_order_acquire))
+            {
+                if (meter->address() == address)
+                {
+                    return meter;
+                }
+                pos = (pos + 1) & mask_;
+            }
+            return nullptr;
+        }
+
+        size_t MeterRegistry::bytesPerMeter() const
+        {
+            size_t values = std::bit_ceil(std::max<size_t>(valuesPerMeter_, 1));
+            // 登记表的桶数按负载因子向上取2的幂，摊到每个表计上（向上取整）
+            size_t bucketBytes = (mask_ + 1) * sizeof(std::atomic<VirtualMeter *>);
+            size_t meters = std::max<size_t>(maxMeters_, 1);
+            // 表计对象 + 值表 + 摊到的桶 + 1个所有权指针
+            return sizeof(VirtualMeter) + values * VirtualMeter::entrySize() + (bucketBytes + meters - 1) / meters
+                   + sizeof(std::unique_ptr<VirtualMeter>);
+        }
+
+    } // namespace service
+} // namespace dlt645
@@ -0,0 +1,80 @@
+#include "dlt645/transport/io_context_pool.h"
+#include <algorithm>
+#include "dlt645/common/log.h"
+
+namespace dlt645
+{
+    namespace transport
+    {
+
+        IoContextPool::IoContextPool(size_t size)
+        {
+            if (size == 0)
+            {
+                size = std::max(1u, std::thread::hardware_concurrency());
+            }
+
+            contexts_.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                // 并发提示为1：每个io_context只由一个线程运行，可省去内部锁
+                contexts_.push_back(std::make_unique<boost::asio::io_context>(1));
+            }
+        }
+
+        IoContextPool::~IoContextPool() { stop(); }
+
+        void IoContextPool::run()
+        {
+            if (!threads_.empty())
+            {
+                return;
+            }
+
+            threads_.reserve(contexts_.size());
+            for (auto &context : contexts_)
+            {
+                // 上次stop后需要重置才能再次运行，工作保护防止没有异步操作时退出
+                context->restart();
+                workGuards_.push_back(boost::asio::make_work_guard(*context));
+                threads_.emplace_back([&context]()
+                                      {
+                    try {
+                        context->run();
+                    } catch (const std::exception& e) {
+                        LOG_ERROR("IO context exception: {}", e.what());
+                    } });
+            }
+        }
+
+        void IoContextPool::stop()
+        {
+            // 移除工作保护并停止所有io_context
+            for (auto &guard : workGuards_)
+            {
+                guard.reset();
+            }
+            workGuards_.clear();
+            for (auto &context : contexts_)
+            {
+                context->stop();
+            }
+
+            // 等待所有线程退出
+            for (auto &thread : threads_)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            threads_.clear();
+        }
+
+        boost::asio::io_context &IoContextPool::next()
+        {
+            return *contexts_[next_.fetch_add(1, std::memory_order_relaxed) % contexts_.size()];
+        }
+
+    } // namespace transport
+} // namespace dlt645
@@ -1,3 +1,4 @@
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <future>
@@ -8,6 +9,7 @@
 #include "dlt645/common/log.h"
 #include "dlt645/transport/client/client_api.h"
 #include "dlt645/common/transform.h"
+#include "dlt645/protocol/protocol.h"
 
 namespace dlt645
 {
@@ -16,45 +18,95 @@ namespace dlt645
         namespace client
         {
 
-            RtuClient::RtuClient()
-                : io_context_(nullptr), isConnected_(false)
+            struct RtuClient::Exchange
+            {
+                explicit Exchange(boost::asio::io_context &io, const std::vector<uint8_t> &frame)
+                    : request(frame), deadline(io), silence(io)
+                {
+                }
+
+                ResponseHandler handler;
+                AdmitHandler admit;                // 写入串口前回调（可为空）
+                SentHandler onSent;                // 请求在线路上发完时回调（可为空）
+                std::chrono::milliseconds timeout; // 本请求的应答超时
+                std::vector<uint8_t> request;
+                std::array<uint8_t, 256> buffer;
+                protocol::FrameDecoder decoder;
+                boost::asio::steady_timer deadline; // 收发切换等待及应答超时
+                boost::asio::steady_timer silence;  // 帧内字节间静默
+                bool done = false;
+            };
+
+            RtuClient::RtuClient(std::shared_ptr<IoContextPool> pool)
+                : pool_(std::move(pool)), io_context_(nullptr), isConnected_(false)
             {
             }
 
             RtuClient::~RtuClient()
             {
-                // 只在连接时才尝试断开连接
-                if (isConnected_)
+                if (!io_context_)
                 {
-                    disconnect();
+                    return;
                 }
-                if (io_thread_.joinable())
+
+                // 异步操作的回调都持有本对象的shared_ptr，析构时已没有会访问本对象的回调；
+                // 最后一个引用可能在IO线程的回调中释放，因此析构不能同步等待IO线程
+                if (io_thread_.joinable() && io_thread_.get_id() != std::this_thread::get_id())
                 {
-                    if (io_context_)
+                    io_context_->stop();
+                    io_thread_.join();
+                }
+
+                auto close = [port = std::shared_ptr<boost::asio::serial_port>(std::move(serial_port_))]()
+                {
+                    if (port && port->is_open())
                     {
-                        io_context_->stop();
+                        boost::system::error_code ec;
+                        port->close(ec);
                     }
-                    io_thread_.join();
+                };
+                if (io_thread_.joinable())
+                {
+                    // 在独占IO线程的回调中析构：直接关闭，线程执行完当前回调后退出
+                    close();
+                    io_context_->stop();
+                    io_thread_.detach();
+                }
+                else if (pool_ && !io_context_->get_executor().running_in_this_thread())
+                {
+                    // 共享池的IO线程可能正在使用串口，交给IO线程关闭
+                    boost::asio::post(*io_context_, std::move(close));
+                }
+                else
+                {
+                    close();
                 }
             }
 
             bool RtuClient::configure(const RtuClientConfig &config)
             {
                 config_ = config;
+                timing_ = RtuTiming(config.baudRate, config.dataBits, config.stopBits, config.parity);
                 return true;
             }
 
             void RtuClient::ensureIoContextRunning()
             {
+                if (!io_context_ && pool_)
+                {
+                    // 别名构造：共享池的所有权，指向池中的一个io_context
+                    io_context_ = std::shared_ptr<boost::asio::io_context>(pool_, &pool_->next());
+                }
                 if (!io_context_)
                 {
                     io_context_ = std::make_shared<boost::asio::io_context>();
-                    io_thread_ = std::thread([this]()
+                    // 线程持有io_context，不访问本对象：析构可能在该线程的回调中发生，此时线程分离后继续退出
+                    io_thread_ = std::thread([io = io_context_]()
                                              {
                         try {
                             boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard(
-                                io_context_->get_executor());
-                            io_context_->run();
+                                io->get_executor());
+                            io->run();
                         } catch (const std::exception& e) {
                             LOG_ERROR("IO Context thread exception: {}", e.what());
                         } });
@@ -138,7 +190,7 @@ namespace dlt645
                     serial_port_ = std::make_unique<boost::asio::serial_port>(*io_context_);
 
                     // 异步打开串口
-                    boost::asio::post(*io_context_, [this, promise]()
+                    boost::asio::post(*io_context_, [self = shared_from_this(), this, promise]()
                                       {
                         try {
                             serial_port_->open(config_.port);
@@ -176,7 +228,7 @@ namespace dlt645
 
                 try
                 {
-                    boost::asio::post(*io_context_, [this, promise]()
+                    boost::asio::post(*io_context_, [self = shared_from_this(), this, promise]()
                                       {
                         try {
                             if (serial_port_ && serial_port_->is_open()) {
@@ -203,100 +255,175 @@ namespace dlt645
                 return future;
             }
 
-            std::future<std::vector<uint8_t>> RtuClient::sendRequestAsync(const std::vector<uint8_t> &frame)
+            void RtuClient::sendRequestAsync(const std::vector<uint8_t> &frame, std::chrono::milliseconds timeout, ResponseHandler handler)
+            {
+                sendRequestAsync(frame, timeout, nullptr, nullptr, std::move(handler));
+            }
+
+            void RtuClient::sendRequestAsync(const std::vector<uint8_t> &frame,
+                                             std::chrono::milliseconds timeout,
+                                             AdmitHandler admit,
+                                             SentHandler onSent,
+                                             ResponseHandler handler)
             {
                 LOG_INFO("TX: {}({})", dlt645::common::bytesToHexString(frame), frame.size());
-                auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
-                auto future = promise->get_future();
 
-                try
+                if (!isConnected_ || !serial_port_ || !serial_port_->is_open())
                 {
-                    if (!isConnected_ || !serial_port_ || !serial_port_->is_open())
-                    {
-                        LOG_ERROR("RTU client not connected");
-                        promise->set_value({});
-                        return future;
+                    LOG_ERROR("RTU client not connected");
+                    handler({});
+                    return;
+                }
+
+                auto exchange = std::make_shared<Exchange>(*io_context_, frame);
+                exchange->handler = std::move(handler);
+                exchange->admit = std::move(admit);
+                exchange->onSent = std::move(onSent);
+                exchange->timeout = timeout.count() > 0 ? timeout : config_.timeout;
+
+                // 总线状态（最后收到字节的时刻）只在IO线程访问
+                boost::asio::post(*io_context_, [self = shared_from_this(), this, exchange]()
+                                  {
+                    // 从站应答后需要时间把RS-485收发器切回接收，收发切换间隔未满时等待
+                    auto ready = lastReceive_ + timing_.turnaround(config_.turnaroundDelay);
+                    if (std::chrono::steady_clock::now() >= ready) {
+                        transmit(exchange);
+                        return;
                     }
+                    exchange->deadline.expires_at(ready);
+                    exchange->deadline.async_wait([self, this, exchange](const boost::system::error_code &error) {
+                        if (error) {
+                            finish(exchange, {});
+                            return;
+                        }
+                        transmit(exchange);
+                    }); });
+            }
 
-                    auto buffer = std::make_shared<std::vector<uint8_t>>(frame);
+            void RtuClient::transmit(const std::shared_ptr<Exchange> &exchange)
+            {
+                if (!serial_port_ || !serial_port_->is_open())
+                {
+                    finish(exchange, {});
+                    return;
+                }
+
+                // 等待收发切换期间调用方可能已不再需要发出，不占用线路直接结束
+                if (exchange->admit && !exchange->admit())
+                {
+                    finish(exchange, {});
+                    return;
+                }
 
-                    // 发送数据
-                    boost::asio::async_write(
-                        *serial_port_,
-                        boost::asio::buffer(*buffer),
-                        [this, promise](const boost::system::error_code &error, std::size_t /*bytes_transferred*/)
+                boost::asio::async_write(
+                    *serial_port_,
+                    boost::asio::buffer(exchange->request),
+                    [self = shared_from_this(), this, exchange](const boost::system::error_code &error, std::size_t /*bytes_transferred*/)
+                    {
+                        if (error)
                         {
-                            if (error)
-                            {
-                                LOG_ERROR("RTU send failed: {}", error.message());
-                                isConnected_ = false;
-                                promise->set_value({});
+                            LOG_ERROR("RTU send failed: {}", error.message());
+                            isConnected_ = false;
+                            finish(exchange, {});
+                            return;
+                        }
+
+                        // 写完成时请求还在驱动缓冲区中，应答超时和往返时延从请求在线路上发完时算起
+                        auto sent = std::chrono::steady_clock::now() + timing_.transmitTime(exchange->request.size());
+                        exchange->deadline.expires_at(sent + exchange->timeout);
+                        exchange->deadline.async_wait([self, this, exchange](const boost::system::error_code &error)
+                                                      {
+                            if (error == boost::asio::error::operation_aborted) {
                                 return;
                             }
+                            LOG_WARN("RTU receive timeout");
+                            finish(exchange, {}); });
+                        if (exchange->onSent)
+                        {
+                            exchange->onSent(sent);
+                        }
 
-                            // 发送成功后接收响应
-                            auto response_buffer = std::make_shared<std::vector<uint8_t>>();
-                            response_buffer->resize(1024); // 预分配空间
-
-                            // 创建一个定时器用于超时控制
-                            auto timer = std::make_shared<boost::asio::steady_timer>(*io_context_, config_.timeout);
-
-                            // 异步读取数据的标志
-                            auto read_in_progress = std::make_shared<bool>(true);
-
-                            // 设置超时处理
-                            timer->async_wait(
-                                [promise, response_buffer, read_in_progress](const boost::system::error_code &error)
-                                {
-                                    if (error == boost::asio::error::operation_aborted)
-                                    {
-                                        // 定时器被取消，说明读取已完成
-                                        return;
-                                    }
-
-                                    if (*read_in_progress)
-                                    {
-                                        *read_in_progress = false;
-                                        LOG_WARN("RTU receive timeout");
-                                        promise->set_value({});
-                                    }
-                                });
-
-                            // 异步读取串口数据
-                            auto read_handler = [this, promise, response_buffer, timer, read_in_progress](
-                                                    const boost::system::error_code &error, std::size_t bytes_read)
-                            {
-                                if (!*read_in_progress)
-                                {
-                                    // 超时已处理
-                                    return;
-                                }
+                        receive(exchange);
+                    });
+            }
 
-                                *read_in_progress = false;
-                                timer->cancel(); // 取消定时器
+            void RtuClient::receive(const std::shared_ptr<Exchange> &exchange)
+            {
+                serial_port_->async_read_some(
+                    boost::asio::buffer(exchange->buffer),
+                    [self = shared_from_this(), this, exchange](const boost::system::error_code &error, std::size_t bytes_read)
+                    {
+                        if (exchange->done)
+                        {
+                            // 超时已处理
+                            return;
+                        }
 
-                                if (error)
-                                {
-                                    LOG_ERROR("RTU receive failed: {}", error.message());
-                                    isConnected_ = false;
-                                    promise->set_value({});
+                        if (error)
+                        {
+                            LOG_ERROR("RTU receive failed: {}", error.message());
+                            isConnected_ = false;
+                            finish(exchange, {});
+                            return;
+                        }
+
+                        lastReceive_ = std::chrono::steady_clock::now();
+
+                        // 按帧长度域判断帧是否收完，响应可能分多次到达
+                        std::vector<uint8_t> response;
+                        exchange->decoder.feed(std::span<const uint8_t>(exchange->buffer.data(), bytes_read),
+                                               [&response](const protocol::FrameView &frame)
+                                               {
+                                                   if (response.empty())
+                                                   {
+                                                       response.assign(frame.raw().begin(), frame.raw().end());
+                                                   }
+                                               });
+                        if (!response.empty())
+                        {
+                            finish(exchange, std::move(response));
+                            return;
+                        }
+
+                        // 帧已开始但未收完：超过字节间静默阈值没有新字节时按截断处理，不必等到应答超时
+                        if (!exchange->decoder.idle())
+                        {
+                            exchange->silence.expires_after(timing_.silence(config_.interCharTimeout));
+                            exchange->silence.async_wait([self, this, exchange](const boost::system::error_code &error)
+                                                         {
+                                if (error || exchange->silence.expiry() > std::chrono::steady_clock::now()) {
                                     return;
                                 }
+                                LOG_WARN("RTU response truncated: no bytes within inter-character timeout");
+                                finish(exchange, {}); });
+                        }
+                        else
+                        {
+                            // 解码器回到空闲（丢弃了无效字节）：没有未收完的帧，上一次的静默计时不再适用
+                            exchange->silence.cancel();
+                        }
 
-                                response_buffer->resize(bytes_read);
-                                promise->set_value(*response_buffer);
-                            };
+                        receive(exchange);
+                    });
+            }
 
-                            serial_port_->async_read_some(boost::asio::buffer(*response_buffer), read_handler);
-                        });
-                }
-                catch (const std::exception &e)
+            void RtuClient::finish(const std::shared_ptr<Exchange> &exchange, std::vector<uint8_t> response)
+            {
+                if (exchange->done)
                 {
-                    LOG_ERROR("Exception in RTU sendRequestAsync: {}", e.what());
-                    promise->set_value({});
+                    return;
                 }
+                exchange->done = true;
+                exchange->deadline.cancel();
+                exchange->silence.cancel();
 
-                return future;
+                // 失败时取消仍在等待的读操作，迟到的字节不会混入下一次交换
+                if (response.empty() && serial_port_ && serial_port_->is_open())
+                {
+                    boost::system::error_code ec;
+                    serial_port_->cancel(ec);
+                }
+                exchange->handler(std::move(response));
             }
 
             bool RtuClient::isConnected() const { return isConnected_; }
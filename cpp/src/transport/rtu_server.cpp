@@ -13,7 +13,7 @@ namespace dlt645
         {
 
             RtuServer::RtuServer()
-                : config_(), io_context_(std::make_shared<boost::asio::io_context>()), serial_port_(), isRunning_(false), connectionHandler_(), io_thread_(), receiveBuffer_()
+                : config_(), io_context_(std::make_shared<boost::asio::io_context>()), serial_port_(), isRunning_(false), connectionHandler_(), io_thread_(), receiveBuffer_(), frameTimer_(*io_context_), turnaroundTimer_(*io_context_)
             {
                 receiveBuffer_.resize(1024);
             }
@@ -30,6 +30,7 @@ namespace dlt645
             bool RtuServer::configure(const RtuServerConfig &config)
             {
                 config_ = config;
+                timing_ = RtuTiming(config.baudRate, config.dataBits, config.stopBits, config.parity);
                 return true;
             }
 
@@ -129,6 +130,15 @@ namespace dlt645
                         return false;
                     }
 
+                    // 清理上次运行遗留的状态（stop后io_context需要restart才能再次run）
+                    io_context_->restart();
+                    decoder_.reset();
+                    outbox_.clear();
+                    inflight_.clear();
+                    writing_ = false;
+                    readPaused_ = false;
+                    turnaroundPending_ = false;
+
                     // 启动io_context线程
                     isRunning_ = true;
                     // 创建工作保护，防止io_context在没有异步操作时退出
@@ -237,42 +247,24 @@ namespace dlt645
             {
                 if (!error)
                 {
-                    std::vector<uint8_t> data(receiveBuffer_.begin(), receiveBuffer_.begin() + bytes_transferred);
+                    std::span<const uint8_t> data(receiveBuffer_.data(), bytes_transferred);
+                    lastReceive_ = std::chrono::steady_clock::now();
 
                     LOG_INFO("RX: {}({})", common::bytesToHexString(data), bytes_transferred);
 
-                    // 处理数据
+                    // 处理数据：分片中的所有完整帧依次处理，响应异步发送，不阻塞接收
                     if (connectionHandler_)
                     {
-                        try
-                        {
-                            // 解析帧
-                            auto frame = protocol::Frame::deserialize(data);
-                            if (!frame)
-                            {
-                                LOG_WARN("Failed to parse frame");
-                                return;
-                            }
-
-                            LOG_DEBUG("Received frame: ctrlCode={}, data length={}", frame->ctrlCode, frame->dataLen);
-
-                            // 调用handleFrame来处理解析后的帧
-                            std::vector<uint8_t> response = connectionHandler_->handleRequest(*frame);
-
-                            // 发送响应
-                            if (!response.empty())
-                            {
-                                boost::asio::write(*serial_port_, boost::asio::buffer(response));
-                                LOG_DEBUG("Sent response to RTU client: {}", common::bytesToHexString(response));
-                            }
-                        }
-                        catch (const std::exception &e)
-                        {
-                            LOG_ERROR("Exception in RTU connection handler: {}", e.what());
-                        }
+                        handleFrames(data);
                     }
+                    armFrameTimer();
 
-                    // 继续接收数据
+                    // 继续接收数据；主站不取走响应导致发送队列积压时暂停读取，写完后恢复
+                    if (outbox_.size() >= MAX_QUEUED_FRAMES)
+                    {
+                        readPaused_ = true;
+                        return;
+                    }
                     startReceive();
                 }
                 else
@@ -299,6 +291,139 @@ namespace dlt645
                 }
             }
 
+            void RtuServer::handleFrames(std::span<const uint8_t> received)
+            {
+                decoder_.feed(received, [this](const protocol::FrameView &frame)
+                              {
+                    LOG_DEBUG("Received frame: ctrlCode={}, data length={}", frame.ctrlCode(), frame.dataLen());
+                    std::vector<uint8_t> response = acquireBuffer();
+                    response.resize(protocol::MAX_ENCODED_LEN);
+                    size_t written = 0;
+                    try {
+                        // 调用handleRequest来处理解析后的帧，响应帧直接写入缓冲区
+                        written = connectionHandler_->handleRequest(frame, response);
+                    } catch (const std::exception &e) {
+                        LOG_ERROR("Exception in RTU connection handler: {}", e.what());
+                    }
+                    response.resize(written);
+                    if (written > 0) {
+                        outbox_.push_back(std::move(response));
+                    } else if (spare_.size() < MAX_SPARE_BUFFERS) {
+                        spare_.push_back(std::move(response));
+                    } });
+
+                // 发送响应
+                flush();
+            }
+
+            void RtuServer::armFrameTimer()
+            {
+                if (decoder_.idle())
+                {
+                    frameTimer_.cancel();
+                    return;
+                }
+
+                // 重新设置到期时间会取消上一次等待
+                frameTimer_.expires_after(timing_.silence(config_.interCharTimeout));
+                frameTimer_.async_wait([this](const boost::system::error_code &error)
+                                       {
+                    // 到期回调已排队后又收到新字节并重设了定时器时，按未到期处理
+                    if (error || decoder_.idle() || frameTimer_.expiry() > std::chrono::steady_clock::now()) {
+                        return;
+                    }
+                    LOG_WARN("RTU frame incomplete after inter-character timeout, discarding partial frame");
+                    decoder_.reset(); });
+            }
+
+            std::vector<uint8_t> RtuServer::acquireBuffer()
+            {
+                if (spare_.empty())
+                {
+                    std::vector<uint8_t> buffer;
+                    buffer.reserve(protocol::MAX_ENCODED_LEN);
+                    return buffer;
+                }
+                std::vector<uint8_t> buffer = std::move(spare_.back());
+                spare_.pop_back();
+                return buffer;
+            }
+
+            void RtuServer::flush()
+            {
+                // 已有写操作时只排队，写完后再把期间积累的响应一起发出，保证响应顺序且不会交错
+                if (writing_ || turnaroundPending_ || outbox_.empty() || !serial_port_ || !serial_port_->is_open())
+                {
+                    return;
+                }
+
+                // 主站发完请求后需要时间把RS-485收发器切回接收，收发切换间隔未满时延后发送
+                auto ready = lastReceive_ + timing_.turnaround(config_.turnaroundDelay);
+                if (std::chrono::steady_clock::now() < ready)
+                {
+                    turnaroundPending_ = true;
+                    turnaroundTimer_.expires_at(ready);
+                    turnaroundTimer_.async_wait([this](const boost::system::error_code &error)
+                                                {
+                        turnaroundPending_ = false;
+                        if (!error && isRunning_) {
+                            flush();
+                        } });
+                    return;
+                }
+
+                writing_ = true;
+                inflight_.swap(outbox_);
+                writeBuffers_.clear();
+                for (const auto &response : inflight_)
+                {
+                    writeBuffers_.push_back(boost::asio::buffer(response));
+                }
+
+                boost::asio::async_write(*serial_port_, writeBuffers_, [this](const boost::system::error_code &error, size_t)
+                                         { onWrite(error); });
+            }
+
+            void RtuServer::onWrite(const boost::system::error_code &error)
+            {
+                writing_ = false;
+                if (error)
+                {
+                    LOG_ERROR("Failed to send RTU response: {}", error.message());
+                }
+                else
+                {
+                    LOG_DEBUG("Sent {} responses to RTU client", inflight_.size());
+                }
+
+                // 回收缓冲区
+                for (auto &response : inflight_)
+                {
+                    if (spare_.size() >= MAX_SPARE_BUFFERS)
+                    {
+                        break;
+                    }
+                    response.clear();
+                    spare_.push_back(std::move(response));
+                }
+                inflight_.clear();
+
+                if (!isRunning_)
+                {
+                    return;
+                }
+
+                // 继续发送写操作期间积累的响应
+                flush();
+
+                // 发送队列已回落，恢复读取
+                if (readPaused_ && outbox_.size() < MAX_QUEUED_FRAMES)
+                {
+                    readPaused_ = false;
+                    startReceive();
+                }
+            }
+
         } // namespace server
     } // namespace transport
 } // namespace dlt645
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "dlt645/transport/rtu_timing.h"
+#include <algorithm>
+
+namespace dlt645
+{
+    namespace transport
+    {
+
+        RtuTiming::RtuTiming(int baudRate, int dataBits, int stopBits, std::string_view parity)
+        {
+            // 起始位1位，有奇偶校验时加1位
+            bitsPerChar_ = 1 + dataBits + (parity == "none" ? 0 : 1) + stopBits;
+            charTime_ = std::chrono::nanoseconds(1000000000LL * bitsPerChar_ / std::max(baudRate, 1));
+        }
+
+        std::chrono::nanoseconds RtuTiming::silence(std::chrono::milliseconds configured) const
+        {
+            if (configured.count() > 0)
+            {
+                return configured;
+            }
+            return std::max<std::chrono::nanoseconds>(transmitTime(SILENCE_CHARS), MIN_SILENCE);
+        }
+
+        std::chrono::nanoseconds RtuTiming::turnaround(std::chrono::microseconds configured) const
+        {
+            if (configured.count() > 0)
+            {
+                return configured;
+            }
+            return transmitTime(TURNAROUND_CHARS);
+        }
+
+    } // namespace transport
+} // namespace dlt645
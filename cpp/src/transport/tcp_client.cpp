@@ -1,6 +1,11 @@
+#include <algorithm>
+#include <array>
+#include <deque>
 #include <boost/asio/steady_timer.hpp>
 #include "dlt645/common/log.h"
 #include "dlt645/common/transform.h"
+#include "dlt645/model/model.h"
+#include "dlt645/protocol/protocol.h"
 #include "dlt645/transport/client/client_api.h"
 #include "log/default_logger.hpp"
 
@@ -11,25 +16,135 @@ namespace dlt645
         namespace client
         {
 
-            TcpClient::TcpClient()
-                : io_context_(nullptr), isConnected_(false)
+            struct TcpClient::Request
+            {
+                Request(boost::asio::io_context &io, const std::vector<uint8_t> &bytes)
+                    : frame(bytes), timer(io)
+                {
+                    // 记录匹配响应用的地址、控制码和数据标识；无法解析的请求与最早发出的响应匹配
+                    if (auto view = protocol::FrameView::parse(frame))
+                    {
+                        parsed = true;
+                        std::ranges::copy(view->addr(), addr.begin());
+                        ctrlCode = view->ctrlCode();
+                        hasDi = ctrlCode == model::CTRL_READ_DATA && view->dataLen() >= 4;
+                        for (size_t i = 0; hasDi && i < di.size(); ++i)
+                        {
+                            di[i] = view->dataAt(i);
+                        }
+                    }
+                }
+
+                // 响应是否属于本请求：地址相同（广播/通配地址除外）、控制码功能位相同、读数据正常应答回带的DI相同
+                bool matches(const protocol::FrameView &response) const
+                {
+                    if (!parsed)
+                    {
+                        return true;
+                    }
+                    auto wildcard = [this](uint8_t b)
+                    { return std::ranges::all_of(addr, [b](uint8_t a)
+                                                 { return a == b; }); };
+                    if (!wildcard(0xAA) && !wildcard(0x99) && !std::ranges::equal(response.addr(), addr))
+                    {
+                        return false;
+                    }
+                    if ((response.ctrlCode() & 0x1F) != (ctrlCode & 0x1F))
+                    {
+                        return false;
+                    }
+                    // 异常应答（D6=1）不带DI，按发出顺序匹配
+                    if (hasDi && !(response.ctrlCode() & 0x40))
+                    {
+                        if (response.dataLen() < di.size())
+                        {
+                            return false;
+                        }
+                        for (size_t i = 0; i < di.size(); ++i)
+                        {
+                            if (response.dataAt(i) != di[i])
+                            {
+                                return false;
+                            }
+                        }
+                    }
+                    return true;
+                }
+
+                std::vector<uint8_t> frame;
+                ResponseHandler handler;
+                AdmitHandler admit;                // 移入发送队列前回调（可为空）
+                SentHandler onSent;                // 发出时回调（可为空）
+                std::chrono::milliseconds timeout; // 本请求的应答超时
+                boost::asio::steady_timer timer; // 从发出时开始计时的响应超时
+                bool parsed = false;
+                bool hasDi = false;
+                bool done = false;
+                std::array<uint8_t, 6> addr = { 0 };
+                uint8_t ctrlCode = 0;
+                std::array<uint8_t, 4> di = { 0 };
+            };
+
+            struct TcpClient::Pipeline
+            {
+                std::deque<std::shared_ptr<Request>> waiting;  // 窗口已满、等待发出的请求
+                std::deque<std::shared_ptr<Request>> inflight; // 已进入发送队列、等待响应的请求（按发出顺序）
+                std::vector<std::shared_ptr<Request>> outbox;  // 等待写出的请求
+                std::vector<std::shared_ptr<Request>> writing; // 正在写出的请求（持有帧缓冲区直到写完）
+                std::vector<boost::asio::const_buffer> writeBuffers;
+                protocol::FrameDecoder decoder;
+                std::array<uint8_t, 1024> readBuffer;
+                bool closed = false;
+            };
+
+            TcpClient::TcpClient(std::shared_ptr<IoContextPool> pool)
+                : pool_(std::move(pool)), io_context_(nullptr), isConnected_(false)
             {
             }
 
             TcpClient::~TcpClient()
             {
-                // 只在连接时才尝试断开连接
-                if (isConnected_)
+                if (!io_context_)
                 {
-                    disconnect();
+                    return;
                 }
-                if (io_thread_.joinable())
+
+                // 异步操作的回调都持有本对象的shared_ptr（读循环只持有weak_ptr），析构时已没有会访问本对象的回调；
+                // 最后一个引用可能在IO线程的回调中释放，因此析构不能同步等待IO线程
+                if (io_thread_.joinable() && io_thread_.get_id() != std::this_thread::get_id())
+                {
+                    io_context_->stop();
+                    io_thread_.join();
+                }
+
+                // 关闭连接，结束流水线中剩余的请求；等待中的读操作随之以operation_aborted结束
+                auto close = [socket = std::shared_ptr<boost::asio::ip::tcp::socket>(std::move(socket_)), pipeline = std::move(pipeline_)]()
                 {
-                    if (io_context_)
+                    if (socket && socket->is_open())
                     {
-                        io_context_->stop();
+                        boost::system::error_code ec;
+                        socket->close(ec);
                     }
-                    io_thread_.join();
+                    if (pipeline)
+                    {
+                        failAll(pipeline);
+                    }
+                };
+                if (io_thread_.joinable())
+                {
+                    // 在独占IO线程的回调中析构：直接关闭，线程执行完当前回调后退出
+                    close();
+                    io_context_->stop();
+                    io_thread_.detach();
+                }
+                else if (pool_ && !io_context_->get_executor().running_in_this_thread())
+                {
+                    // 共享池的IO线程可能正在使用socket，交给IO线程关闭
+                    boost::asio::post(*io_context_, std::move(close));
+                }
+                else
+                {
+                    close();
                 }
             }
 
@@ -41,15 +156,21 @@ namespace dlt645
 
             void TcpClient::ensureIoContextRunning()
             {
+                if (!io_context_ && pool_)
+                {
+                    // 别名构造：共享池的所有权，指向池中的一个io_context
+                    io_context_ = std::shared_ptr<boost::asio::io_context>(pool_, &pool_->next());
+                }
                 if (!io_context_)
                 {
                     io_context_ = std::make_shared<boost::asio::io_context>();
-                    io_thread_ = std::thread([this]()
+                    // 线程持有io_context，不访问本对象：析构可能在该线程的回调中发生，此时线程分离后继续退出
+                    io_thread_ = std::thread([io = io_context_]()
                                              {
                         try {
                             boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard(
-                                io_context_->get_executor());
-                            io_context_->run();
+                                io->get_executor());
+                            io->run();
                         } catch (const std::exception& e) {
                             LOG_ERROR("IO Context thread exception: {}", e.what());
                         } });
@@ -79,7 +200,7 @@ namespace dlt645
                     auto completed = std::make_shared<std::atomic<bool>>(false);
 
                     // 设置定时器回调
-                    timer->async_wait([this, promise, completed](const boost::system::error_code &ec)
+                    timer->async_wait([self = shared_from_this(), this, promise, completed](const boost::system::error_code &ec)
                                       {
                         if (!completed->exchange(true)) { // 如果是第一个完成的操作
                             if (ec != boost::asio::error::operation_aborted) {
@@ -94,7 +215,7 @@ namespace dlt645
                             }
                         } });
 
-                    socket_->async_connect(endpoint, [this, promise, timer, completed](const boost::system::error_code &error)
+                    socket_->async_connect(endpoint, [self = shared_from_this(), this, promise, timer, completed](const boost::system::error_code &error)
                                            {
                         // 取消定时器
                         timer->cancel();
@@ -102,6 +223,8 @@ namespace dlt645
                         if (!completed->exchange(true)) { // 如果是第一个完成的操作
                             if (!error) {
                                 isConnected_ = true;
+                                pipeline_ = std::make_shared<Pipeline>();
+                                readLoop(pipeline_);
                                 LOG_INFO("TCP client connected to {}:{} successfully", config_.ip, config_.port);
                                 promise->set_value(true);
                             } else {
@@ -129,7 +252,7 @@ namespace dlt645
 
                 try
                 {
-                    boost::asio::post(*io_context_, [this, promise]()
+                    boost::asio::post(*io_context_, [self = shared_from_this(), this, promise]()
                                       {
                         try {
                             if (socket_ && socket_->is_open()) {
@@ -140,6 +263,10 @@ namespace dlt645
                                 }
                             }
                             isConnected_ = false;
+                            if (pipeline_) {
+                                failAll(pipeline_);
+                                pipeline_.reset();
+                            }
                             LOG_INFO("TCP client disconnected");
                             promise->set_value();
                         } catch (const std::exception& e) {
@@ -156,97 +283,192 @@ namespace dlt645
                 return future;
             }
 
-            std::future<std::vector<uint8_t>> TcpClient::sendRequestAsync(const std::vector<uint8_t> &frame)
+            void TcpClient::sendRequestAsync(const std::vector<uint8_t> &frame, std::chrono::milliseconds timeout, ResponseHandler handler)
+            {
+                sendRequestAsync(frame, timeout, nullptr, nullptr, std::move(handler));
+            }
+
+            void TcpClient::sendRequestAsync(const std::vector<uint8_t> &frame,
+                                             std::chrono::milliseconds timeout,
+                                             AdmitHandler admit,
+                                             SentHandler onSent,
+                                             ResponseHandler handler)
             {
                 LOG_INFO("TX: {}({})", dlt645::common::bytesToHexString(frame), frame.size());
-                auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
-                auto future = promise->get_future();
 
-                try
+                if (!isConnected_ || !socket_ || !socket_->is_open())
                 {
-                    if (!isConnected_ || !socket_ || !socket_->is_open())
+                    LOG_ERROR("TCP client not connected");
+                    handler({});
+                    return;
+                }
+
+                auto request = std::make_shared<Request>(*io_context_, frame);
+                request->handler = std::move(handler);
+                request->admit = std::move(admit);
+                request->onSent = std::move(onSent);
+                request->timeout = timeout.count() > 0 ? timeout : config_.timeout;
+
+                // 流水线状态只在IO线程访问
+                boost::asio::post(*io_context_, [self = shared_from_this(), this, request]()
+                                  {
+                    auto pipeline = pipeline_;
+                    if (!pipeline || pipeline->closed) {
+                        complete(request, {});
+                        return;
+                    }
+                    pipeline->waiting.push_back(request);
+                    pump(pipeline); });
+            }
+
+            void TcpClient::pump(const std::shared_ptr<Pipeline> &pipeline)
+            {
+                const size_t window = std::max<size_t>(config_.maxInFlight, 1);
+                while (!pipeline->waiting.empty() && pipeline->inflight.size() < window)
+                {
+                    auto request = std::move(pipeline->waiting.front());
+                    pipeline->waiting.pop_front();
+
+                    // 在窗口外排队期间调用方可能已不再需要发出（如设备已熔断），不占用窗口直接结束
+                    if (request->admit && !request->admit())
+                    {
+                        complete(request, {});
+                        continue;
+                    }
+
+                    // 每个请求单独计时，超时只结束该请求，不影响窗口内的其他请求
+                    request->timer.expires_after(request->timeout);
+                    request->timer.async_wait([self = shared_from_this(), this, pipeline, request](const boost::system::error_code &error)
+                                              {
+                        if (error || request->done) {
+                            return;
+                        }
+                        LOG_WARN("TCP receive timeout");
+                        std::erase(pipeline->inflight, request);
+                        complete(request, {});
+                        pump(pipeline); });
+                    if (request->onSent)
                     {
-                        LOG_ERROR("TCP client not connected");
-                        promise->set_value({});
-                        return future;
+                        request->onSent(std::chrono::steady_clock::now());
                     }
 
-                    auto buffer = std::make_shared<std::vector<uint8_t>>(frame);
-                    boost::asio::async_write(
-                        *socket_,
-                        boost::asio::buffer(*buffer),
-                        [this, promise](const boost::system::error_code &error, std::size_t /*bytes_transferred*/)
+                    pipeline->inflight.push_back(request);
+                    pipeline->outbox.push_back(std::move(request));
+                }
+                flush(pipeline);
+            }
+
+            void TcpClient::flush(const std::shared_ptr<Pipeline> &pipeline)
+            {
+                // 已有写操作时只排队，写完后把期间积累的请求一起发出
+                if (!pipeline->writing.empty() || pipeline->outbox.empty() || pipeline->closed)
+                {
+                    return;
+                }
+
+                pipeline->writing.swap(pipeline->outbox);
+                pipeline->writeBuffers.clear();
+                for (const auto &request : pipeline->writing)
+                {
+                    pipeline->writeBuffers.push_back(boost::asio::buffer(request->frame));
+                }
+
+                boost::asio::async_write(
+                    *socket_,
+                    pipeline->writeBuffers,
+                    [self = shared_from_this(), this, pipeline](const boost::system::error_code &error, std::size_t /*bytes_transferred*/)
+                    {
+                        pipeline->writing.clear();
+                        if (error)
                         {
-                            if (error)
+                            if (!pipeline->closed)
                             {
                                 LOG_ERROR("TCP send failed: {}", error.message());
                                 isConnected_ = false;
-                                promise->set_value({});
-                                return;
                             }
+                            failAll(pipeline);
+                            return;
+                        }
+                        flush(pipeline);
+                    });
+            }
 
-                            // 发送成功后接收响应
-                            auto response_buffer = std::make_shared<std::vector<uint8_t>>();
-                            response_buffer->resize(1024); // 预分配空间
-
-                            // 使用steady_timer实现超时
-                            auto timer = std::make_shared<boost::asio::steady_timer>(*io_context_);
-                            timer->expires_after(config_.timeout);
-
-                            // 创建一个取消令牌，用于取消操作
-                            auto cancel_token = std::make_shared<boost::system::error_code>();
-
-                            // 设置定时器回调
-                            timer->async_wait(
-                                [this, promise, response_buffer, cancel_token](const boost::system::error_code &ec)
-                                {
-                                    if (ec != boost::asio::error::operation_aborted)
-                                    {
-                                        // 超时，取消读取操作
-                                        *cancel_token = boost::asio::error::timed_out;
-                                        socket_->cancel();
-                                        LOG_WARN("TCP receive timeout");
-                                        promise->set_value({});
-                                    }
-                                });
-
-                            socket_->async_read_some(boost::asio::buffer(*response_buffer),
-                                                     [this, promise, response_buffer, timer, cancel_token](
-                                                         const boost::system::error_code &error, std::size_t bytes_read)
-                                                     {
-                                                         // 取消定时器
-                                                         timer->cancel();
-
-                                                         // 检查是否是因为定时器超时导致的取消
-                                                         if (*cancel_token == boost::asio::error::timed_out)
-                                                         {
-                                                             return; // 已经处理过了
-                                                         }
-
-                                                         if (error)
-                                                         {
-                                                             if (error != boost::asio::error::operation_aborted)
-                                                             {
-                                                                 LOG_ERROR("TCP receive failed: {}", error.message());
-                                                                 isConnected_ = false;
-                                                             }
-                                                             promise->set_value({});
-                                                             return;
-                                                         }
-
-                                                         response_buffer->resize(bytes_read);
-
-                                                         promise->set_value(*response_buffer);
-                                                     });
-                        });
+            void TcpClient::readLoop(const std::shared_ptr<Pipeline> &pipeline)
+            {
+                // 读操作在连接期间一直等待，只持有weak_ptr：调用方释放客户端后不因此保持连接
+                socket_->async_read_some(
+                    boost::asio::buffer(pipeline->readBuffer),
+                    [weak = weak_from_this(), pipeline](const boost::system::error_code &error, std::size_t bytes_read)
+                    {
+                        auto self = weak.lock();
+                        if (!self)
+                        {
+                            failAll(pipeline);
+                            return;
+                        }
+                        self->onRead(pipeline, error, bytes_read);
+                    });
+            }
+
+            void TcpClient::onRead(const std::shared_ptr<Pipeline> &pipeline, const boost::system::error_code &error, std::size_t bytes_read)
+            {
+                if (error)
+                {
+                    if (error != boost::asio::error::operation_aborted && !pipeline->closed)
+                    {
+                        LOG_ERROR("TCP receive failed: {}", error.message());
+                        isConnected_ = false;
+                    }
+                    failAll(pipeline);
+                    return;
                 }
-                catch (const std::exception &e)
+
+                // 响应可能分多次到达，也可能一次到达多个；每个完整帧交给最早发出的匹配请求
+                pipeline->decoder.feed(
+                    std::span<const uint8_t>(pipeline->readBuffer.data(), bytes_read),
+                    [&pipeline](const protocol::FrameView &frame)
+                    {
+                        auto it = std::ranges::find_if(pipeline->inflight, [&frame](const std::shared_ptr<Request> &request)
+                                                       { return request->matches(frame); });
+                        if (it == pipeline->inflight.end())
+                        {
+                            LOG_DEBUG("Discarding unmatched TCP response: {}", common::bytesToHexString(frame.raw()));
+                            return;
+                        }
+                        auto request = *it;
+                        pipeline->inflight.erase(it);
+                        complete(request, std::vector<uint8_t>(frame.raw().begin(), frame.raw().end()));
+                    });
+
+                pump(pipeline);
+                readLoop(pipeline);
+            }
+
+            void TcpClient::complete(const std::shared_ptr<Request> &request, std::vector<uint8_t> response)
+            {
+                if (request->done)
                 {
-                    LOG_ERROR("Exception in TCP sendRequestAsync: {}", e.what());
-                    promise->set_value({});
+                    return;
                 }
+                request->done = true;
+                request->timer.cancel();
+                request->handler(std::move(response));
+            }
 
-                return future;
+            void TcpClient::failAll(const std::shared_ptr<Pipeline> &pipeline)
+            {
+                pipeline->closed = true;
+                for (auto &request : pipeline->inflight)
+                {
+                    complete(request, {});
+                }
+                for (auto &request : pipeline->waiting)
+                {
+                    complete(request, {});
+                }
+                pipeline->inflight.clear();
+                pipeline->waiting.clear();
+                pipeline->outbox.clear();
             }
 
             bool TcpClient::isConnected() const { return isConnected_; }
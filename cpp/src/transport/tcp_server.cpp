@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <thread>
 #include <vector>
@@ -12,20 +14,64 @@ namespace dlt645
         namespace server
         {
 
-            TcpServer::TcpServer()
-                : io_context_(std::make_shared<boost::asio::io_context>()), isRunning_(false)
+            // TCP连接：socket、空闲计时器和流式解码器，所有异步操作都在socket所属io_context的线程上完成
+            class TcpConnection : public std::enable_shared_from_this<TcpConnection>
             {
-            }
+            public:
+                TcpConnection(TcpServer &server, boost::asio::ip::tcp::socket socket);
+
+                // 开始接收数据并启动空闲计时
+                void start();
+
+                // 关闭连接并从服务器登记表中移除（在连接所在线程调用）
+                void close(bool evicted);
+
+                boost::asio::any_io_executor executor() { return socket_.get_executor(); }
+
+            private:
+                void armIdleTimer();
+                void onIdleTimer();
+                void doRead();
+                void onRead(const boost::system::error_code &error, size_t bytes_transferred);
+
+                // 处理一次读取中的所有完整帧，响应帧放入发送队列
+                void handleFrames(std::span<const uint8_t> received);
+
+                // 发送队列中的全部响应合并为一次写操作（同一时刻只有一个写操作）
+                void flush();
+                void onWrite(const boost::system::error_code &error);
+
+                // 取一个空闲的响应缓冲区
+                std::vector<uint8_t> acquireBuffer();
+
+                // 发送队列超过该帧数时暂停读取，等待对端收走响应
+                static constexpr size_t MAX_QUEUED_FRAMES = 64;
+                // 保留的空闲缓冲区个数上限
+                static constexpr size_t MAX_SPARE_BUFFERS = 16;
+
+                TcpServer &server_;
+                boost::asio::ip::tcp::socket socket_;
+                boost::asio::steady_timer idleTimer_;
+                protocol::FrameDecoder decoder_; // 每个连接维护独立的流式解码器
+                std::array<uint8_t, 1024> readBuffer_;
+                bool closed_ = false;
+
+                // 发送队列：outbox_为等待发送的响应，inflight_为正在写的响应，写完后缓冲区回收到spare_重复使用
+                std::vector<std::vector<uint8_t>> outbox_;
+                std::vector<std::vector<uint8_t>> inflight_;
+                std::vector<std::vector<uint8_t>> spare_;
+                std::vector<boost::asio::const_buffer> writeBuffers_; // 分散/聚集写的缓冲区序列
+                bool writing_ = false;
+                bool readPaused_ = false;
+            };
 
-            TcpServer::~TcpServer()
+            TcpServer::TcpServer()
+                : isRunning_(false)
             {
-                stop();
-                if (io_thread_.joinable())
-                {
-                    io_thread_.join();
-                }
             }
 
+            TcpServer::~TcpServer() { stop(); }
+
             bool TcpServer::configure(const TcpServerConfig &config)
             {
                 config_ = config;
@@ -42,29 +88,41 @@ namespace dlt645
 
                 try
                 {
+                    // 创建io_context池，线程数在启动时按配置确定（旧acceptor引用旧池，需先释放）
+                    acceptors_.clear();
+                    pool_ = std::make_unique<IoContextPool>(static_cast<size_t>(std::max(config_.ioThreads, 0)));
+
                     // 创建acceptor
                     boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::make_address(config_.ip), config_.port);
 
-                    acceptor_ = std::make_unique<boost::asio::ip::tcp::acceptor>(*io_context_, endpoint);
+#ifdef SO_REUSEPORT
+                    bool reusePort = config_.reusePort;
+#else
+                    bool reusePort = false;
+                    if (config_.reusePort)
+                    {
+                        LOG_WARN("SO_REUSEPORT is not supported on this platform, using a single acceptor");
+                    }
+#endif
+                    size_t acceptorCount = reusePort ? pool_->size() : 1;
+                    for (size_t i = 0; i < acceptorCount; ++i)
+                    {
+                        acceptors_.push_back(openAcceptor(pool_->at(i), endpoint, reusePort));
+                    }
 
-                    // 启动io_context线程
                     isRunning_ = true;
-                    // 创建工作保护，防止io_context在没有异步操作时退出
-                    work_guard_.emplace(boost::asio::make_work_guard(*io_context_));
 
                     // 开始接受连接（先创建异步操作）
-                    acceptConnection();
-
-                    // 然后启动io_context线程
-                    io_thread_ = std::thread([this]()
-                                             {
-                        try {
-                            io_context_->run();
-                        } catch (const std::exception& e) {
-                            LOG_ERROR("TCP server IO context exception: {}", e.what());
-                        } });
-
-                    LOG_INFO("TCP server started on {}:{}", config_.ip, config_.port);
+                    for (size_t i = 0; i < acceptors_.size(); ++i)
+                    {
+                        acceptConnection(i);
+                    }
+
+                    // 然后启动IO线程
+                    pool_->run();
+
+                    LOG_INFO("TCP server started on {}:{} with {} IO threads and {} acceptors",
+                             config_.ip, config_.port, pool_->size(), acceptors_.size());
                     return true;
                 }
                 catch (const std::exception &e)
@@ -87,30 +145,30 @@ namespace dlt645
                     isRunning_ = false;
 
                     // 关闭acceptor，停止接受新连接
-                    if (acceptor_)
+                    for (auto &acceptor : acceptors_)
                     {
                         boost::system::error_code ec;
-                        acceptor_->close(ec);
+                        acceptor->close(ec);
                         if (ec)
                         {
                             LOG_WARN("Failed to close acceptor: {}", ec.message());
                         }
                     }
 
-                    // 移除工作保护，允许io_context退出
-                    if (work_guard_)
+                    // 停止所有io_context并等待IO线程退出
+                    if (pool_)
                     {
-                        work_guard_->reset();
-                        work_guard_.reset(); // 释放optional
+                        pool_->stop();
                     }
 
-                    // 停止io_context
-                    io_context_->stop();
-
-                    // 等待io_thread_退出
-                    if (io_thread_.joinable())
+                    // IO线程已退出，释放登记的连接
                     {
-                        io_thread_.join();
+                        std::lock_guard<std::mutex> lock(connectionsMutex_);
+                        connections_.clear();
+                        waiting_.clear();
+                        pausedAcceptors_.clear();
+                        stats_.connections = 0;
+                        stats_.queuedConnections = 0;
                     }
 
                     LOG_INFO("TCP server stopped");
@@ -120,11 +178,11 @@ namespace dlt645
                     LOG_ERROR("Failed to stop TCP server: {}", e.what());
                     // 确保在异常情况下也能正确清理
                     isRunning_ = false;
-                    if (io_thread_.joinable())
+                    if (pool_)
                     {
                         try
                         {
-                            io_thread_.join();
+                            pool_->stop();
                         }
                         catch (...)
                         {
@@ -138,39 +196,63 @@ namespace dlt645
 
             void TcpServer::setConnectionHandler(std::shared_ptr<ConnectionHandler> handler) { connectionHandler_ = handler; }
 
-            void TcpServer::acceptConnection()
+            std::unique_ptr<boost::asio::ip::tcp::acceptor> TcpServer::openAcceptor(boost::asio::io_context &context,
+                                                                                    const boost::asio::ip::tcp::endpoint &endpoint,
+                                                                                    bool reusePort)
             {
-                if (!isRunning_ || !acceptor_)
+                auto acceptor = std::make_unique<boost::asio::ip::tcp::acceptor>(context);
+                acceptor->open(endpoint.protocol());
+                acceptor->set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+                if (reusePort)
                 {
-                    return;
+                    // 同一ip:port上的多个监听套接字，内核按四元组哈希把新连接分散到各个套接字的接受队列
+                    acceptor->set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
                 }
+#else
+                (void)reusePort;
+#endif
+                acceptor->bind(endpoint);
+                acceptor->listen();
+                return acceptor;
+            }
 
-                auto socket = std::make_shared<boost::asio::ip::tcp::socket>(*io_context_);
+            void TcpServer::acceptConnection(size_t index)
+            {
+                if (!isRunning_ || index >= acceptors_.size())
+                {
+                    return;
+                }
 
-                acceptor_->async_accept(*socket, [this, socket](const boost::system::error_code &error)
+                // 单acceptor时新连接按轮询分配到池中的io_context；多acceptor时留在接受它的io_context上
+                // 之后该连接的读写和请求处理都在对应线程上完成
+                boost::asio::ip::tcp::acceptor &acceptor = *acceptors_[index];
+                boost::asio::io_context &target = acceptors_.size() > 1 ? pool_->at(index) : pool_->next();
+                acceptor.async_accept(target, [this, index](const boost::system::error_code &error, boost::asio::ip::tcp::socket peer)
                                         {
                     try {
                         if (!error) {
-                            LOG_INFO("New TCP connection from {}", socket->remote_endpoint().address().to_string());
+                            LOG_INFO("New TCP connection from {}", peer.remote_endpoint().address().to_string());
 
-                            // 处理客户端连接
-                            handleClient(socket);
-                        } else {
-                            if (isRunning_) {
-                                LOG_ERROR("Failed to accept TCP connection: {}", error.message());
-                            }
+                            // 准入控制，由admit决定是否继续接受下一个连接
+                            admit(index, std::move(peer));
+                            return;
+                        }
+
+                        if (isRunning_) {
+                            LOG_ERROR("Failed to accept TCP connection: {}", error.message());
                         }
 
                         // 继续接受下一个连接
                         if (isRunning_) {
-                            acceptConnection();
+                            acceptConnection(index);
                         }
                     } catch (const std::exception &e) {
                         if (isRunning_) {
                             LOG_ERROR("Exception in accept callback: {}", e.what());
                             // 继续接受下一个连接
                             if (isRunning_) {
-                                acceptConnection();
+                                acceptConnection(index);
                             }
                         }
                     } catch (...) {
@@ -178,124 +260,349 @@ namespace dlt645
                             LOG_ERROR("Unknown exception in accept callback");
                             // 继续接受下一个连接
                             if (isRunning_) {
-                                acceptConnection();
+                                acceptConnection(index);
                             }
                         }
                     } });
             }
 
-            void TcpServer::handleClient(std::shared_ptr<boost::asio::ip::tcp::socket> socket)
+            void TcpServer::admit(size_t index, boost::asio::ip::tcp::socket socket)
             {
-                auto buffer = std::make_shared<std::vector<uint8_t>>(1024);
-
-                socket->async_read_some(
-                    boost::asio::buffer(*buffer),
-                    [this, socket, buffer](const boost::system::error_code &error, size_t bytes_transferred)
+                auto connection = std::make_shared<TcpConnection>(*this, std::move(socket));
+                size_t limit = static_cast<size_t>(std::max(config_.maxConnections, 0));
+                bool start = false;
+                bool resume = true;
+                {
+                    std::lock_guard<std::mutex> lock(connectionsMutex_);
+                    stats_.acceptedConnections++;
+                    if (limit > 0 && connections_.size() >= limit)
                     {
-                        try
+                        if (config_.admissionPolicy == AdmissionPolicy::Reject)
                         {
-                            if (!error)
-                            {
-                                buffer->resize(bytes_transferred);
-
-                                LOG_INFO(
-                                    "RX: {}({})", common::bytesToHexString(*buffer), bytes_transferred);
-
-                                // 处理数据
-                                if (connectionHandler_)
-                                {
-                                    // 解析帧
-                                    auto frame = protocol::Frame::deserialize(*buffer);
-                                    if (!frame)
-                                    {
-                                        LOG_WARN("Failed to parse frame");
-                                        // 继续接收数据
-                                        handleClient(socket);
-                                        return;
-                                    }
-
-                                    LOG_DEBUG("Received frame: ctrlCode={}, data length={}", frame->ctrlCode, frame->dataLen);
-
-                                    // 调用handleFrame来处理解析后的帧
-                                    std::vector<uint8_t> response = connectionHandler_->handleRequest(*frame);
-
-                                    // 发送响应
-                                    if (!response.empty())
-                                    {
-                                        boost::asio::async_write(
-                                            *socket,
-                                            boost::asio::buffer(response),
-                                            [socket, response](const boost::system::error_code &error, size_t)
-                                            {
-                                                try
-                                                {
-                                                    if (error)
-                                                    {
-                                                        LOG_ERROR("Failed to send TCP response: {}", error.message());
-                                                    }
-                                                    else
-                                                    {
-                                                        LOG_DEBUG("Sent response to TCP client: {}",
-                                                                  common::bytesToHexString(response));
-                                                    }
-                                                }
-                                                catch (const std::exception &e)
-                                                {
-                                                    LOG_ERROR("Exception in async_write callback: {}", e.what());
-                                                }
-                                                catch (...)
-                                                {
-                                                    LOG_ERROR("Unknown exception in async_write callback");
-                                                }
-                                            });
-                                    }
-                                }
-
-                                // 继续接收数据
-                                handleClient(socket);
-                            }
-                            else
-                            {
-                                LOG_INFO("TCP client disconnected: {}", error.message());
-
-                                // 通知连接关闭
-                                if (connectionHandler_)
-                                {
-                                    connectionHandler_->onConnectionClosed();
-                                }
-                            }
+                            // 拒绝：关闭连接后照常接受
+                            stats_.rejectedConnections++;
                         }
-                        catch (const std::exception &e)
+                        else
                         {
-                            LOG_ERROR("Exception in async_read_some callback: {}", e.what());
-                            // 即使发生异常，也要确保继续接受新连接
-                            if (isRunning_ && !socket->is_open())
-                            {
-                                // 如果socket已关闭，不要继续调用handleClient
-                                LOG_INFO("TCP client socket closed due to exception");
-                            }
-                            else if (isRunning_)
-                            {
-                                // 继续接收数据
-                                handleClient(socket);
-                            }
+                            // 排队：其他acceptor同时接受导致超限，连接暂不启动，acceptor暂停
+                            waiting_.push_back(connection);
+                            stats_.queuedConnections = waiting_.size();
+                            pausedAcceptors_.push_back(index);
+                            resume = false;
                         }
-                        catch (...)
+                    }
+                    else
+                    {
+                        connections_.insert(connection);
+                        stats_.connections = connections_.size();
+                        stats_.peakConnections = std::max(stats_.peakConnections, stats_.connections);
+                        start = true;
+
+                        // 连接数已满：暂停该acceptor，新连接留在内核监听队列中
+                        if (limit > 0 && connections_.size() >= limit && config_.admissionPolicy == AdmissionPolicy::Queue)
                         {
-                            LOG_ERROR("Unknown exception in async_read_some callback");
-                            // 即使发生异常，也要确保继续接受新连接
-                            if (isRunning_ && !socket->is_open())
-                            {
-                                // 如果socket已关闭，不要继续调用handleClient
-                                LOG_INFO("TCP client socket closed due to unknown exception");
-                            }
-                            else if (isRunning_)
-                            {
-                                // 继续接收数据
-                                handleClient(socket);
-                            }
+                            pausedAcceptors_.push_back(index);
+                            resume = false;
                         }
-                    });
+                    }
+                }
+
+                if (start)
+                {
+                    connection->start();
+                }
+                else if (resume)
+                {
+                    // 未登记的连接释放即关闭socket
+                    LOG_WARN("TCP connection limit {} reached, rejecting connection", limit);
+                    connection.reset();
+                }
+
+                // 继续接受下一个连接
+                if (resume && isRunning_)
+                {
+                    acceptConnection(index);
+                }
+            }
+
+            void TcpServer::release(const std::shared_ptr<TcpConnection> &connection, bool evicted)
+            {
+                std::shared_ptr<TcpConnection> next;
+                std::optional<size_t> resume;
+                {
+                    std::lock_guard<std::mutex> lock(connectionsMutex_);
+                    if (connections_.erase(connection) == 0)
+                    {
+                        return; // 被拒绝的连接未登记
+                    }
+                    if (evicted)
+                    {
+                        stats_.evictedConnections++;
+                    }
+
+                    // 空出的位置优先给排队的连接，否则恢复一个暂停的acceptor
+                    if (!waiting_.empty())
+                    {
+                        next = std::move(waiting_.front());
+                        waiting_.pop_front();
+                        connections_.insert(next);
+                    }
+                    else if (!pausedAcceptors_.empty())
+                    {
+                        resume = pausedAcceptors_.back();
+                        pausedAcceptors_.pop_back();
+                    }
+                    stats_.connections = connections_.size();
+                    stats_.queuedConnections = waiting_.size();
+                }
+
+                if (next)
+                {
+                    // 排队的连接在其所属io_context上启动
+                    boost::asio::post(next->executor(), [next]()
+                                      { next->start(); });
+                }
+                if (resume && isRunning_)
+                {
+                    size_t index = *resume;
+                    boost::asio::post(acceptors_[index]->get_executor(), [this, index]()
+                                      { acceptConnection(index); });
+                }
+            }
+
+            TcpServerStats TcpServer::stats() const
+            {
+                std::lock_guard<std::mutex> lock(connectionsMutex_);
+                return stats_;
+            }
+
+            TcpConnection::TcpConnection(TcpServer &server, boost::asio::ip::tcp::socket socket)
+                : server_(server), socket_(std::move(socket)), idleTimer_(socket_.get_executor())
+            {
+            }
+
+            void TcpConnection::start()
+            {
+                armIdleTimer();
+                doRead();
+            }
+
+            void TcpConnection::close(bool evicted)
+            {
+                if (closed_)
+                {
+                    return;
+                }
+                closed_ = true;
+
+                boost::system::error_code ec;
+                socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+                socket_.close(ec);
+                idleTimer_.cancel();
+
+                // 通知连接关闭
+                if (server_.connectionHandler_)
+                {
+                    server_.connectionHandler_->onConnectionClosed();
+                }
+                server_.release(shared_from_this(), evicted);
+            }
+
+            void TcpConnection::armIdleTimer()
+            {
+                if (server_.config_.timeout.count() <= 0)
+                {
+                    return;
+                }
+
+                // 每次收到数据都会推迟到期时间，等待被取消后按新的到期时间重新等待
+                idleTimer_.expires_after(server_.config_.timeout);
+                idleTimer_.async_wait([self = shared_from_this()](const boost::system::error_code &)
+                                      { self->onIdleTimer(); });
+            }
+
+            void TcpConnection::onIdleTimer()
+            {
+                if (closed_)
+                {
+                    return;
+                }
+                if (idleTimer_.expiry() <= std::chrono::steady_clock::now())
+                {
+                    LOG_INFO("TCP client idle for {} ms, closing connection", server_.config_.timeout.count());
+                    close(true);
+                    return;
+                }
+                idleTimer_.async_wait([self = shared_from_this()](const boost::system::error_code &)
+                                      { self->onIdleTimer(); });
+            }
+
+            void TcpConnection::doRead()
+            {
+                socket_.async_read_some(
+                    boost::asio::buffer(readBuffer_),
+                    [self = shared_from_this()](const boost::system::error_code &error, size_t bytes_transferred)
+                    { self->onRead(error, bytes_transferred); });
+            }
+
+            void TcpConnection::onRead(const boost::system::error_code &error, size_t bytes_transferred)
+            {
+                if (closed_)
+                {
+                    return;
+                }
+
+                try
+                {
+                    if (error)
+                    {
+                        LOG_INFO("TCP client disconnected: {}", error.message());
+                        close(false);
+                        return;
+                    }
+
+                    // 收到数据，推迟空闲超时
+                    if (server_.config_.timeout.count() > 0)
+                    {
+                        idleTimer_.expires_after(server_.config_.timeout);
+                    }
+
+                    std::span<const uint8_t> received(readBuffer_.data(), bytes_transferred);
+                    LOG_INFO("RX: {}({})", common::bytesToHexString(received), bytes_transferred);
+
+                    // 处理数据
+                    if (server_.connectionHandler_)
+                    {
+                        handleFrames(received);
+                    }
+                }
+                catch (const std::exception &e)
+                {
+                    LOG_ERROR("Exception in async_read_some callback: {}", e.what());
+                }
+                catch (...)
+                {
+                    LOG_ERROR("Unknown exception in async_read_some callback");
+                }
+
+                // 继续接收数据；对端不收响应导致发送队列积压时暂停读取，写完后恢复
+                if (!closed_ && socket_.is_open())
+                {
+                    if (outbox_.size() >= MAX_QUEUED_FRAMES)
+                    {
+                        readPaused_ = true;
+                        return;
+                    }
+                    doRead();
+                }
+            }
+
+            void TcpConnection::handleFrames(std::span<const uint8_t> received)
+            {
+                // 一次读取中的所有完整帧依次处理，每个响应写入一个复用的缓冲区
+                decoder_.feed(received, [this](const protocol::FrameView &frame)
+                              {
+                    LOG_DEBUG("Received frame: ctrlCode={}, data length={}", frame.ctrlCode(), frame.dataLen());
+                    std::vector<uint8_t> response = acquireBuffer();
+                    response.resize(protocol::MAX_ENCODED_LEN);
+                    size_t written = 0;
+                    try {
+                        // 调用handleRequest来处理解析后的帧，响应帧直接写入缓冲区
+                        written = server_.connectionHandler_->handleRequest(frame, response);
+                    } catch (const std::exception &e) {
+                        LOG_ERROR("Exception in TCP connection handler: {}", e.what());
+                    }
+                    response.resize(written);
+                    if (written > 0) {
+                        outbox_.push_back(std::move(response));
+                    } else if (spare_.size() < MAX_SPARE_BUFFERS) {
+                        spare_.push_back(std::move(response));
+                    } });
+
+                // 发送响应
+                flush();
+            }
+
+            std::vector<uint8_t> TcpConnection::acquireBuffer()
+            {
+                if (spare_.empty())
+                {
+                    std::vector<uint8_t> buffer;
+                    buffer.reserve(protocol::MAX_ENCODED_LEN);
+                    return buffer;
+                }
+                std::vector<uint8_t> buffer = std::move(spare_.back());
+                spare_.pop_back();
+                return buffer;
+            }
+
+            void TcpConnection::flush()
+            {
+                // 已有写操作时只排队，写完后再把期间积累的响应一起发出，保证响应顺序且不会交错
+                if (writing_ || outbox_.empty() || closed_)
+                {
+                    return;
+                }
+
+                writing_ = true;
+                inflight_.swap(outbox_);
+                writeBuffers_.clear();
+                for (const auto &response : inflight_)
+                {
+                    writeBuffers_.push_back(boost::asio::buffer(response));
+                }
+
+                boost::asio::async_write(
+                    socket_,
+                    writeBuffers_,
+                    [self = shared_from_this()](const boost::system::error_code &error, size_t)
+                    { self->onWrite(error); });
+            }
+
+            void TcpConnection::onWrite(const boost::system::error_code &error)
+            {
+                writing_ = false;
+                if (error)
+                {
+                    LOG_ERROR("Failed to send TCP response: {}", error.message());
+                }
+                else
+                {
+                    LOG_DEBUG("Sent {} responses to TCP client", inflight_.size());
+                }
+
+                // 回收缓冲区
+                for (auto &response : inflight_)
+                {
+                    if (spare_.size() >= MAX_SPARE_BUFFERS)
+                    {
+                        break;
+                    }
+                    response.clear();
+                    spare_.push_back(std::move(response));
+                }
+                inflight_.clear();
+
+                if (closed_)
+                {
+                    return;
+                }
+                if (error)
+                {
+                    // 读取可能因发送队列积压而暂停，没有挂起的读操作能发现连接已断开，这里直接关闭并释放名额
+                    close(false);
+                    return;
+                }
+
+                // 继续发送写操作期间积累的响应
+                flush();
+
+                // 发送队列已回落，恢复读取
+                if (readPaused_ && outbox_.size() < MAX_QUEUED_FRAMES)
+                {
+                    readPaused_ = false;
+                    doRead();
+                }
             }
 
         } // namespace server